@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/processors/corner_detectors/FastDetector.h>
+#include <dvsal/processors/corner_detectors/HarrisDetector.h>
+#include <dvsal/processors/corner_detectors/ArcStarDetector.h>
+#include <dvsal/processors/corner_detectors/FastHarrisDetector.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+// Synthetic stream: edges of a square moving diagonally across the sensor plus uniform noise.
+std::vector<dv::EventStore> syntheticStream(int _packets, int _eventsPerPacket){
+    std::mt19937 rng(42);
+    std::vector<dv::EventStore> stream(_packets);
+
+    int64_t timestamp = 0;
+    for (int p = 0; p < _packets; p++){
+        const int corner_x = 20 + (p % 160);
+        const int corner_y = 20 + (p % 100);
+
+        for (int i = 0; i < _eventsPerPacket; i++){
+            timestamp += 1;
+            int x, y;
+            if (rng() % 10 == 0){
+                x = rng() % 240;
+                y = rng() % 180;
+            } else {
+                const int side = rng() % 4;
+                const int offset = rng() % 50;
+                x = corner_x + (side == 1 ? 50 : side == 3 ? 0 : offset);
+                y = corner_y + (side == 0 ? 0 : side == 2 ? 50 : offset);
+            }
+            stream[p].add(dv::Event(timestamp, static_cast<int16_t>(x), static_cast<int16_t>(y), static_cast<uint8_t>(rng() & 1)));
+        }
+    }
+    return stream;
+}
+
+void report(const std::string &_name, const std::vector<dv::EventStore> &_stream, const std::function<size_t(const dv::EventStore &)> &_run){
+    size_t events = 0, corners = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const auto &packet : _stream){
+        events  += packet.size();
+        corners += _run(packet);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << _name << ": " << events / seconds * 1e-6 << " Mev/s, " << corners << " corners" << std::endl;
+}
+
+template<typename Detector_>
+void benchmark(const std::string &_name, const std::vector<dv::EventStore> &_stream){
+    Detector_ perEvent;
+    dvsal::Detector *virtualDetector = &perEvent;
+    report(_name + " virtual isFeature", _stream, [&](const dv::EventStore &_packet){
+        size_t corners = 0;
+        for (const auto &e : _packet)
+            corners += virtualDetector->isFeature(e);
+        return corners;
+    });
+
+    Detector_ batched;
+    std::vector<dv::Event> events;
+    std::vector<uint8_t> isCorner;
+    report(_name + " isFeatureBatch", _stream, [&](const dv::EventStore &_packet){
+        events.assign(_packet.begin(), _packet.end());
+        isCorner.resize(events.size());
+        return batched.isFeatureBatch(events.data(), events.size(), isCorner.data(), nullptr);
+    });
+
+    Detector_ callback;
+    report(_name + " Detector::eventCallback", _stream, [&](const dv::EventStore &_packet){
+        callback.eventCallback(_packet);
+        return callback.cornersDetected().size();
+    });
+}
+
+// Parallel mode must find the same corners as the serial path, including tile counts that do
+// not divide the sensor. Returns the number of tilings that differ.
+template<typename Detector_>
+int checkParallel(const std::string &_name, const std::vector<dv::EventStore> &_stream){
+    const int tilings[][2] = {{3, 2}, {7, 7}, {9, 8}, {11, 13}, {14, 16}, {17, 11}};
+
+    int failures = 0;
+    for (const auto &tiling : tilings){
+        Detector_ serial, parallel;
+        if (!parallel.enableParallelMode(tiling[0], tiling[1])){
+            continue;
+        }
+
+        bool same = true;
+        for (const auto &packet : _stream){
+            std::vector<dv::Event> serialCorners, parallelCorners;
+            serial.eventCallback(packet, serialCorners);
+            parallel.eventCallback(packet, parallelCorners);
+
+            same = same && serialCorners.size() == parallelCorners.size() &&
+                   std::equal(serialCorners.begin(), serialCorners.end(), parallelCorners.begin(),
+                              [](const dv::Event &_a, const dv::Event &_b){
+                                  return _a.timestamp() == _b.timestamp() && _a.x() == _b.x() && _a.y() == _b.y();
+                              });
+        }
+
+        if (!same){
+            std::cout << _name << ": parallel mode " << tiling[0] << "x" << tiling[1] << " differs from serial" << std::endl;
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(int _argc, char **_argv){
+
+    const int packets = _argc > 1 ? std::atoi(_argv[1]) : 200;
+    const std::vector<dv::EventStore> stream = syntheticStream(packets, 10000);
+
+    benchmark<dvsal::FastDetector>("FAST", stream);
+    benchmark<dvsal::HarrisDetector>("HARRIS", stream);
+    benchmark<dvsal::ArcStarDetector>("ARC*", stream);
+    benchmark<dvsal::FastHarrisDetector>("FAST-HARRIS", stream);
+
+    const std::vector<dv::EventStore> checkStream(stream.begin(), stream.begin() + std::min<size_t>(stream.size(), 20));
+    int failures = 0;
+    failures += checkParallel<dvsal::FastDetector>("FAST", checkStream);
+    failures += checkParallel<dvsal::HarrisDetector>("HARRIS", checkStream);
+    failures += checkParallel<dvsal::ArcStarDetector>("ARC*", checkStream);
+    failures += checkParallel<dvsal::FastHarrisDetector>("FAST-HARRIS", checkStream);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/streamers/DatasetStreamer.h>
+#include <dvsal/processors/filters/BackgroundActivityFilter.h>
+#include <dvsal/processors/corner_detectors/FastDetector.h>
+#include <dvsal/pipeline/Pipeline.h>
+
+#include <atomic>
+
+int main(int _argc, char **_argv){
+
+    if (_argc < 2){
+        std::cout << "Usage: " << _argv[0] << " <dataset_path> [batch_size]" << std::endl;
+        return 0;
+    }
+
+    std::string datasetPath = _argv[1];
+    const std::size_t batchSize = _argc > 2 ? std::stoul(_argv[2]) : 1000;
+
+    dvsal::Streamer *streamer = dvsal::Streamer::create<dvsal::DatasetStreamer>(datasetPath);
+    if (!streamer->init()){
+        std::cout << "Error creating streamer" << std::endl;
+        return 0;
+    }
+
+    dvsal::BackgroundActivityFilter filter;
+    dvsal::FastDetector detector;
+
+    // streamer, filter, detector and sink on four threads
+    std::atomic<uint64_t> corners{0};
+    dvsal::Pipeline pipeline(streamer, batchSize);
+    pipeline.addFilter(&filter);
+    pipeline.addDetector(&detector);
+    pipeline.addSink([&](const dv::EventStore &_corners){
+        corners += _corners.size();
+    });
+
+    pipeline.start();
+    pipeline.wait();
+
+    std::cout << "corners detected: " << corners << std::endl;
+    std::cout << "finished program" << std::endl;
+
+    delete streamer;
+    return 0;
+}
@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PIPELINE_BOUNDED_QUEUE_H_
+#define DVSAL_PIPELINE_BOUNDED_QUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace dvsal{
+
+  // Blocking FIFO of at most _capacity items joining two pipeline stages. push blocks while the
+  // queue is full, which throttles the producer to the pace of the consumer (backpressure).
+  template<typename Item_>
+  class BoundedQueue{
+    public:
+      BoundedQueue(std::size_t _capacity);
+
+      // false if the queue was closed, the item is discarded
+      bool push(Item_ _item);
+
+      // false once the queue is closed and drained
+      bool pop(Item_ &_item);
+
+      // wake every waiting thread, pending items can still be popped
+      void close();
+
+      std::size_t size() const;
+
+    private:
+      mutable std::mutex mutex_;
+      std::condition_variable notFull_;
+      std::condition_variable notEmpty_;
+      std::deque<Item_> items_;
+      std::size_t capacity_;
+      bool closed_ = false;
+  };
+
+} // namespace
+
+#include "BoundedQueue.inl"
+
+#endif
@@ -0,0 +1,71 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+namespace dvsal{
+
+  template<typename Item_>
+  BoundedQueue<Item_>::BoundedQueue(std::size_t _capacity) : capacity_(_capacity > 0 ? _capacity : 1){
+  }
+
+  template<typename Item_>
+  bool BoundedQueue<Item_>::push(Item_ _item){
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this](){ return closed_ || items_.size() < capacity_; });
+    if (closed_){
+      return false;
+    }
+    items_.push_back(std::move(_item));
+    lock.unlock();
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  template<typename Item_>
+  bool BoundedQueue<Item_>::pop(Item_ &_item){
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this](){ return closed_ || !items_.empty(); });
+    if (items_.empty()){
+      return false;
+    }
+    _item = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    notFull_.notify_one();
+    return true;
+  }
+
+  template<typename Item_>
+  void BoundedQueue<Item_>::close(){
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    notFull_.notify_all();
+    notEmpty_.notify_all();
+  }
+
+  template<typename Item_>
+  std::size_t BoundedQueue<Item_>::size() const{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size();
+  }
+
+} // namespace
@@ -0,0 +1,122 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PIPELINE_PIPELINE_H_
+#define DVSAL_PIPELINE_PIPELINE_H_
+
+#include <dvsal/pipeline/BoundedQueue.h>
+#include <dvsal/streamers/Streamer.h>
+#include <dvsal/processors/filters/EventFilter.h>
+#include <dvsal/processors/corner_detectors/Detector.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dvsal{
+
+  // Streamer followed by a chain of stages, each running on its own thread. Packets of at
+  // most _batchSize events are pulled from the streamer with nextPacket and handed from stage
+  // to stage through BoundedQueues of _queueCapacity packets, so throughput is bounded by the
+  // slowest stage and memory by the queue capacities.
+  //
+  //    dvsal::Pipeline pipeline(streamer, 1000);
+  //    pipeline.addFilter(&filter);
+  //    pipeline.addDetector(&detector);          // packets are the corners from here on
+  //    pipeline.addSink([](const dv::EventStore &_corners){ ... });
+  //    pipeline.start();
+  //    pipeline.wait();
+  //
+  // Streamer, filters and detectors are not owned and must outlive the pipeline. Stages are
+  // added before start.
+  class Pipeline{
+    public:
+      // transform the packet in place, return false to drop it
+      typedef std::function<bool(dv::EventStore &)> StageFunction;
+      typedef std::function<void(const dv::EventStore &)> SinkFunction;
+
+      Pipeline(Streamer *_streamer, std::size_t _batchSize = 1000, std::size_t _queueCapacity = 8);
+      ~Pipeline();
+
+      Pipeline(const Pipeline &) = delete;
+      Pipeline &operator=(const Pipeline &) = delete;
+
+      // _cpu pins the thread of the stage to that core, -1 leaves it to the scheduler
+      void addStage(const std::string &_name, StageFunction _function, int _cpu = -1);
+
+      // keep the events passing _filter
+      void addFilter(EventFilter *_filter, int _cpu = -1);
+
+      // replace the packet with the corners found by _detector. The stage collects the corners
+      // itself, a corner sink set on _detector is not called.
+      void addDetector(Detector *_detector, int _cpu = -1);
+
+      // consume the packets, the last stage
+      void addSink(SinkFunction _sink, int _cpu = -1);
+
+      // pin the streamer thread
+      void setStreamerAffinity(int _cpu);
+
+      // launch the threads, false if already running
+      bool start();
+
+      // block until the streamer is exhausted and every packet went through the stages
+      void wait();
+
+      // stop pulling from the streamer, drop queued packets and join the threads
+      void stop();
+
+      // packets that left stage _idx
+      uint64_t packetsProcessed(std::size_t _idx) const {
+        return stages_[_idx]->packets;
+      }
+
+    private:
+      struct Stage{
+        std::string name;
+        StageFunction function;
+        int cpu;
+        std::atomic<uint64_t> packets{0};
+      };
+
+      void sourceLoop();
+      void stageLoop(std::size_t _idx);
+      void join();
+
+    private:
+      Streamer *streamer_;
+      std::size_t batchSize_;
+      std::size_t queueCapacity_;
+      int streamerCpu_ = -1;
+
+      std::vector<std::unique_ptr<Stage>> stages_;
+      // queues_[i] feeds stage i
+      std::vector<std::unique_ptr<BoundedQueue<dv::EventStore>>> queues_;
+      std::vector<std::thread> threads_;
+      std::atomic<bool> running_{false};
+  };
+
+} // namespace
+
+#endif
@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_CORNERDETECTORS_ARC_STAR_DETECTOR_H_
+#define DVSAL_PROCESSORS_CORNERDETECTORS_ARC_STAR_DETECTOR_H_
+
+#include <Eigen/Dense>
+#include "dvsal/processors/corner_detectors/Detector.h"
+#include "dvsal/processors/corner_detectors/utils/CircleOffsets.h"
+
+namespace dvsal{
+
+  // Arc* corner detector. I. Alzugaray and M. Chli, "Asynchronous Corner Detection and Tracking
+  // for Event Cameras in Real Time", RA-L 2018.
+  //
+  // Events are first filtered: the SAE of a pixel is only refreshed when the previous event of
+  // the same polarity is older than filterThreshold_ or when the polarity changed in between.
+  // The corner test then grows, from the newest element of each circle, the arc of newest
+  // timestamps, expanding at each step towards the newer of its two neighbours. The event is a
+  // corner if the arc length lies in the valid range on both circles.
+  class ArcStarDetector : public Detector{
+    public:
+      ArcStarDetector(double _filterThreshold = 0.05);
+      virtual ~ArcStarDetector();
+
+      virtual std::string name() override {return "ARC*";}
+      virtual QWidget * customWidget() override {return nullptr;}
+
+      virtual Detector * newInstance() const override {return new ArcStarDetector(filterThreshold_);}
+      virtual int supportRadius() const override {return 4;}
+
+      bool isFeature(const dv::Event &e);
+      std::size_t isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores) override;
+      void updateState(const dv::Event &e) override;
+
+    private:
+      // filter the event and refresh the SAE, false if the event was filtered out
+      bool updateSae(const dv::Event &e);
+
+      // length of the arc of newest timestamps grown from the newest element of the circle,
+      // _arcMinT is set to the oldest timestamp of that arc
+      template<int CircleSize_>
+      int newestArcSize(const Eigen::MatrixXd &_sae, int _x, int _y, const int (&_circle)[CircleSize_][2], int _minArc,
+                        double &_arcMinT) const;
+
+      template<int CircleSize_>
+      bool isValidArc(int _arcSize, int _minArc, int _maxArc) const;
+
+    private:
+      // filtered SAE and latest timestamp of every pixel
+      Eigen::MatrixXd sae_[2];
+      Eigen::MatrixXd saeLatest_[2];
+
+      // parameters
+      double filterThreshold_;
+  };
+}
+
+#include "ArcStarDetector.inl"
+
+#endif
\ No newline at end of file
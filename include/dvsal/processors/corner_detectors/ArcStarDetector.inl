@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+namespace dvsal{
+
+  inline bool ArcStarDetector::updateSae(const dv::Event &e){
+    const int pol = e.polarity() ? 1 : 0;
+    const double t = e.timestamp() * 0.000001;
+
+    // filter events refiring too soon with the same polarity
+    double &t_last = saeLatest_[pol](e.x(), e.y());
+    const double t_last_inv = saeLatest_[1-pol](e.x(), e.y());
+    const bool refreshed = (t > t_last + filterThreshold_) || (t_last_inv > t_last);
+    t_last = t;
+    if (refreshed){
+      sae_[pol](e.x(), e.y()) = t;
+    }
+    return refreshed;
+  }
+
+  inline void ArcStarDetector::updateState(const dv::Event &e){
+    updateSae(e);
+  }
+
+  inline bool ArcStarDetector::isFeature(const dv::Event &e){
+    if (!updateSae(e)){
+      return false;
+    }
+    const int pol = e.polarity() ? 1 : 0;
+
+    // only check if not too close to border
+    const int cs = 4;
+    if (e.x() < cs || e.x() >= sensorWidth_-cs || e.y() < cs || e.y() >= sensorHeight_-cs){
+      return false;
+    }
+
+    double arc_min_t;
+    const int arc3 = newestArcSize(sae_[pol], e.x(), e.y(), CircleOffsets::circle3, 3, arc_min_t);
+    if (!isValidArc<16>(arc3, 3, 6)){
+      return false;
+    }
+
+    const int arc4 = newestArcSize(sae_[pol], e.x(), e.y(), CircleOffsets::circle4, 4, arc_min_t);
+    if (!isValidArc<20>(arc4, 4, 8)){
+      return false;
+    }
+
+    // score: how much newer the arc is than the rest of the large circle
+    double max_rest_t = 0.0;
+    for (int i=0; i<20; i++){
+      const double t_i = sae_[pol](e.x()+CircleOffsets::circle4[i][0], e.y()+CircleOffsets::circle4[i][1]);
+      if (t_i < arc_min_t && t_i > max_rest_t)
+        max_rest_t = t_i;
+    }
+    lastScore_ = arc_min_t - max_rest_t;
+
+    return true;
+  }
+
+  template<int CircleSize_>
+  inline int ArcStarDetector::newestArcSize(const Eigen::MatrixXd &_sae, int _x, int _y,
+                                            const int (&_circle)[CircleSize_][2], int _minArc,
+                                            double &_arcMinT) const{
+    // newest element of the circle
+    int newest = 0;
+    double segment_min_t = _sae(_x+_circle[0][0], _y+_circle[0][1]);
+    for (int i=1; i<CircleSize_; i++){
+      const double t = _sae(_x+_circle[i][0], _y+_circle[i][1]);
+      if (t > segment_min_t){
+        segment_min_t = t;
+        newest = i;
+      }
+    }
+
+    // clockwise and counter clockwise candidates around the arc
+    int cw_idx  = (newest+1)%CircleSize_;
+    int ccw_idx = (newest-1+CircleSize_)%CircleSize_;
+    double cw_t  = _sae(_x+_circle[cw_idx][0], _y+_circle[cw_idx][1]);
+    double ccw_t = _sae(_x+_circle[ccw_idx][0], _y+_circle[ccw_idx][1]);
+    double cw_min_t  = cw_t;
+    double ccw_min_t = ccw_t;
+
+    int arc_size = _minArc;
+    for (int iteration=1; iteration<CircleSize_; iteration++){
+      // the first elements always join the arc
+      const bool grow = iteration < _minArc;
+
+      if (cw_t > ccw_t){
+        if (grow || cw_t >= segment_min_t){
+          if (!grow){
+            arc_size = iteration+1;
+          }
+          if (cw_min_t < segment_min_t){
+            segment_min_t = cw_min_t;
+          }
+        }
+        cw_idx = (cw_idx+1)%CircleSize_;
+        cw_t = _sae(_x+_circle[cw_idx][0], _y+_circle[cw_idx][1]);
+        if (cw_t < cw_min_t){
+          cw_min_t = cw_t;
+        }
+      }
+      else{
+        if (grow || ccw_t >= segment_min_t){
+          if (!grow){
+            arc_size = iteration+1;
+          }
+          if (ccw_min_t < segment_min_t){
+            segment_min_t = ccw_min_t;
+          }
+        }
+        ccw_idx = (ccw_idx-1+CircleSize_)%CircleSize_;
+        ccw_t = _sae(_x+_circle[ccw_idx][0], _y+_circle[ccw_idx][1]);
+        if (ccw_t < ccw_min_t){
+          ccw_min_t = ccw_t;
+        }
+      }
+    }
+
+    _arcMinT = segment_min_t;
+    return arc_size;
+  }
+
+  template<int CircleSize_>
+  inline bool ArcStarDetector::isValidArc(int _arcSize, int _minArc, int _maxArc) const{
+    // newest arc covering a minority of the circle, or its complement
+    return (_arcSize <= _maxArc) ||
+           (_arcSize >= CircleSize_-_maxArc && _arcSize <= CircleSize_-_minArc);
+  }
+
+} // namespace
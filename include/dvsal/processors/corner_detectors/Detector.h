@@ -32,32 +32,174 @@
 #include <QLineEdit>
 
 #include <iostream>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <dvsal/processors/corner_detectors/utils/NonMaxSuppression.h>
+#include <dvsal/processors/filters/EventFilter.h>
+
 namespace dvsal{
 
   class Detector{
     public:
+      typedef std::function<void(const dv::Event &, double)> CornerSink;
+
       Detector();
       virtual ~Detector();
 
       // check if event
       virtual bool isFeature(const dv::Event &e) = 0;
 
-      virtual dv::EventStore cornersDetected(){
+      // check a contiguous batch of events in order, _isCorner[i] is set to 1 for corners and 0
+      // otherwise, and _scores[i] to the score of every corner if _scores is not null. Returns
+      // the number of corners.
+      virtual std::size_t isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores);
+
+      // update the detector state with e without scoring it, so later events are still scored
+      // against a complete history. Used by load shedding, defaults to isFeature.
+      virtual void updateState(const dv::Event &e) { isFeature(e); }
+
+      // score of the last corner found by isFeature, larger is stronger
+      double getLastScore() const {
+        return lastScore_;
+      }
+
+      // new detector with the same parameters and empty state, nullptr if not supported
+      virtual Detector * newInstance() const { return nullptr; }
+
+      // radius around an event where isFeature reads or writes state, negative if unknown
+      virtual int supportRadius() const { return -1; }
+
+      // corners of the last eventCallback without a caller buffer, empty while a sink is set
+      const dv::EventStore &cornersDetected() const {
         return cornersDetected_;
       }
 
-      // interface
+      // scores of cornersDetected(), in the same order
+      const std::vector<double> &cornerScores() const {
+        return cornerScores_;
+      }
+
+      // interface. Builds a new dv::EventStore for cornersDetected() on every call; the sink and
+      // the caller buffer overloads below avoid that allocation.
       void eventCallback(const dv::EventStore &_msg);
 
+      // same, corners and their scores are written to caller owned buffers that are cleared
+      // first. A reused buffer needs no allocation once it has grown to the burst size.
+      void eventCallback(const dv::EventStore &_msg, std::vector<dv::Event> &_corners);
+      void eventCallback(const dv::EventStore &_msg, std::vector<dv::Event> &_corners, std::vector<double> &_scores);
+
+      // push every corner and its score to _sink, in event order, instead of storing them. The
+      // corners of a batch are delivered once the whole batch is processed, at the end of
+      // eventCallback(const dv::EventStore &). nullptr to disable.
+      void setCornerSink(CornerSink _sink);
+
+      // keep only corners that are the strongest within _radius pixels over the last
+      // _timeWindow microseconds, see NonMaxSuppression
+      void enableNonMaxSuppression(int _radius, int64_t _timeWindow);
+      void disableNonMaxSuppression();
+
+      // run _filter, after the filters already added, on every batch before detection. Only
+      // events that pass every filter are seen by the detector. _filter is not owned, must
+      // outlive the detector and must not be shared with another one.
+      void addFilter(EventFilter *_filter);
+      void clearFilters();
+
       virtual QWidget * customWidget() = 0;
       virtual std::string name() = 0;
 
+      // Split the sensor in _tilesX x _tilesY tiles processed concurrently. Every tile owns a
+      // detector created with newInstance() that sees, in order, the events of the tile plus a
+      // halo of supportRadius() pixels, so corners are identical to the serial path. State
+      // accumulated before enabling the mode is not carried over. Returns false if the
+      // detector does not support it.
+      bool enableParallelMode(int _tilesX, int _tilesY);
+      void disableParallelMode();
+
+      // events handled by the load shedding since the last reset
+      struct SheddingStats{
+        uint64_t processed   = 0;   // fully scored
+        uint64_t updatedOnly = 0;   // state updated, not scored
+        uint64_t dropped     = 0;   // ignored
+      };
+
+      // Bound the time spent in every eventCallback to about _budget microseconds. The cost of
+      // scoring and of updateState are measured online on a sample of the events; when a batch
+      // would overrun the budget, part of its events only update the state and, if that is
+      // still too slow, part of them are dropped. Kept events are spread evenly over the batch.
+      // Only applies to the serial path.
+      void enableLoadShedding(int64_t _budget);
+      void disableLoadShedding();
+
+      const SheddingStats &sheddingStats() const {
+        return sheddingStats_;
+      }
+      void resetSheddingStats() {
+        sheddingStats_ = SheddingStats();
+      }
+
     protected:
+      // isFeatureBatch of a concrete detector: the qualified call is resolved statically, so
+      // Detector_::isFeature is inlined into the loop instead of called through the vtable
+      template<typename Detector_>
+      static std::size_t batchLoop(Detector_ &_detector, const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores){
+        std::size_t corners = 0;
+        for (std::size_t i = 0; i < _size; i++){
+          _isCorner[i] = _detector.Detector_::isFeature(_events[i]);
+          if (_scores != nullptr && _isCorner[i])
+            _scores[i] = _detector.lastScore_;
+          corners += _isCorner[i];
+        }
+        return corners;
+      }
+
       std::string detectorName_;
 
+      // written by isFeature for every corner
+      double lastScore_ = 0.0;
+
+      static const int sensorWidth_  = 240;
+      static const int sensorHeight_ = 180;
+
+    private:
+      // filter batch_ and fill isCorner_ and scores_ for its events
+      void detect();
+      void parallelDetect();
+      void sheddingDetect();
+
     private:
       dv::EventStore cornersDetected_;
-      
+      std::vector<double> cornerScores_;
+      CornerSink cornerSink_;
+      std::unique_ptr<NonMaxSuppression> nonMaxSuppression_;
+      std::vector<EventFilter *> filters_;
+
+      struct Tile{
+        int xMin, xMax, yMin, yMax;   // pixels owned by the tile
+        std::unique_ptr<Detector> detector;
+        std::vector<std::size_t> indices;
+        std::vector<dv::Event> events;
+        std::vector<uint8_t> isCorner;
+        std::vector<double> scores;
+      };
+      std::vector<Tile> tiles_;
+      int tilesX_ = 0;
+      int tilesY_ = 0;
+
+      // first and last tile column whose core or halo contains every sensor column, same for rows
+      std::vector<int> columnTileMin_, columnTileMax_;
+      std::vector<int> rowTileMin_, rowTileMax_;
+
+      int64_t sheddingBudget_ = 0;    // microseconds per batch, 0 if disabled
+      double fullCost_   = 0.0;       // measured seconds per event, 0 until measured
+      double updateCost_ = 0.0;
+      SheddingStats sheddingStats_;
+
+      std::vector<dv::Event> batch_;
+      std::vector<uint8_t> isCorner_;
+      std::vector<double> scores_;
+
   };
 }
 
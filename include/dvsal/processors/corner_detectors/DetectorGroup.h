@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_CORNERDETECTORS_DETECTOR_GROUP_H_
+#define DVSAL_PROCESSORS_CORNERDETECTORS_DETECTOR_GROUP_H_
+
+#include <dvsal/processors/corner_detectors/Detector.h>
+#include <dvsal/processors/surfaces/TimeSurface.h>
+
+#include <vector>
+
+namespace dvsal{
+
+  // Several detectors fed from one shared TimeSurface. Every event updates the surface once
+  // and is then passed to each detector in turn, so detectors built on the surface (e.g.
+  // FastDetector(group.surface())) see it exactly as their own SAE would be. Detectors keeping
+  // other state (Harris queues, Arc* filter) can be attached too and update it as usual.
+  //
+  // The group calls isFeature directly, not Detector::eventCallback, so the per detector
+  // filters, non-maximum suppression, load shedding, corner sink and parallel mode are not
+  // applied to grouped detectors. Filter the events before the group and suppress the
+  // corners after it if needed.
+  class DetectorGroup{
+    public:
+      DetectorGroup(int _width = 240, int _height = 180);
+
+      const TimeSurface &surface() const {
+        return surface_;
+      }
+
+      // _detector is not owned and must outlive the group. Returns its index.
+      std::size_t addDetector(Detector *_detector);
+
+      std::size_t size() const {
+        return detectors_.size();
+      }
+
+      void eventCallback(const dv::EventStore &_msg);
+
+      // corners of detector _idx in the last eventCallback, and their scores
+      const dv::EventStore &cornersDetected(std::size_t _idx) const {
+        return detectors_[_idx].corners;
+      }
+      const std::vector<double> &cornerScores(std::size_t _idx) const {
+        return detectors_[_idx].scores;
+      }
+
+    private:
+      TimeSurface surface_;
+
+      struct Entry{
+        Detector *detector;
+        dv::EventStore corners;
+        std::vector<double> scores;
+      };
+      std::vector<Entry> detectors_;
+  };
+
+} // namespace
+
+#endif
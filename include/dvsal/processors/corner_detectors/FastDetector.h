@@ -25,29 +25,42 @@
 #include <deque>
 #include <Eigen/Dense>
 #include "dvsal/processors/corner_detectors/Detector.h"
+#include "dvsal/processors/corner_detectors/utils/CircleOffsets.h"
+#include "dvsal/processors/surfaces/TimeSurface.h"
 namespace dvsal{
   class FastDetector : public Detector{
     public:
       FastDetector();
+
+      // read the SAE from _surface instead of keeping one, the surface must be updated with
+      // every event before it is passed to isFeature and outlive the detector. A surface whose
+      // size is not the detector sensor size is rejected and the detector keeps its own SAE.
+      FastDetector(const TimeSurface &_surface);
       virtual ~FastDetector();
 
+      FastDetector(const FastDetector &) = delete;
+      FastDetector &operator=(const FastDetector &) = delete;
+
       virtual std::string name() override {return "FAST";}
       virtual QWidget * customWidget() override {return nullptr;}
 
+      // tiles cannot share a surface updated outside of the detector
+      virtual Detector * newInstance() const override {return surface_ ? nullptr : new FastDetector();}
+      bool sharesSurface() const {return surface_ != nullptr;}
+      virtual int supportRadius() const override {return 4;}
+
       bool isFeature(const dv::Event &e);
+      void updateState(const dv::Event &e) override;
+      std::size_t isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores) override;
 
     private:
-      // SAE
-      Eigen::MatrixXd sae_[2];
-
-      // pixels on circle
-      int circle3_[16][2];
-      int circle4_[20][2];
-
-      // parameters
-      static const int sensorWidth_ = 240;
-      static const int sensorHeight_ = 180;
+      // SAE, either ownSae_ or the shared surface
+      Eigen::MatrixXd ownSae_[2];
+      const Eigen::MatrixXd *sae_;
+      const TimeSurface *surface_ = nullptr;
   };
 }
 
+#include "FastDetector.inl"
+
 #endif
\ No newline at end of file
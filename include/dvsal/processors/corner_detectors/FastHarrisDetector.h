@@ -0,0 +1,61 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_CORNERDETECTORS_FAST_HARRIS_DETECTOR_H_
+#define DVSAL_PROCESSORS_CORNERDETECTORS_FAST_HARRIS_DETECTOR_H_
+
+#include <algorithm>
+
+#include "dvsal/processors/corner_detectors/Detector.h"
+#include "dvsal/processors/corner_detectors/FastDetector.h"
+#include "dvsal/processors/corner_detectors/HarrisDetector.h"
+
+namespace dvsal{
+
+  // Harris score gated by FAST. Every event updates both the FAST SAE and the Harris queues,
+  // but the Harris score is only evaluated for FAST candidates.
+  class FastHarrisDetector : public Detector{
+    public:
+      FastHarrisDetector();
+
+      // FAST reads its SAE from _surface, see FastDetector
+      FastHarrisDetector(const TimeSurface &_surface);
+      virtual ~FastHarrisDetector();
+
+      virtual std::string name() override {return "FAST-HARRIS";}
+      virtual QWidget * customWidget() override {return nullptr;}
+
+      virtual Detector * newInstance() const override {return fast_.sharesSurface() ? nullptr : new FastHarrisDetector();}
+      virtual int supportRadius() const override {return std::max(fast_.supportRadius(), harris_.supportRadius());}
+
+      bool isFeature(const dv::Event &e);
+      std::size_t isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores) override;
+      void updateState(const dv::Event &e) override;
+
+    private:
+      FastDetector fast_;
+      HarrisDetector harris_;
+  };
+}
+
+#include "FastHarrisDetector.inl"
+
+#endif
\ No newline at end of file
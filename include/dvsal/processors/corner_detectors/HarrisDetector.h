@@ -33,36 +33,44 @@ namespace dvsal{
 
   class HarrisDetector : public Detector{
   public:
-    HarrisDetector();
+    // with _lazyQueues the queue pages are only allocated for the tiles that receive events,
+    // see DistinctQueue. Saves memory for sparse scenes and for the tile detectors of the
+    // parallel mode, which only touch their own region.
+    explicit HarrisDetector(bool _lazyQueues = false);
     virtual ~HarrisDetector();
 
+    HarrisDetector(const HarrisDetector &) = delete;
+    HarrisDetector &operator=(const HarrisDetector &) = delete;
+
     bool isFeature(const dv::Event &e);
 
+    // the two halves of isFeature: push the event to the queues, then score it if its queue is full
+    void updateQueues(const dv::Event &e);
+    void updateQueues(const dv::Event *_events, std::size_t _size) {queues_->newEvents(_events, _size);}
+    bool isCorner(const dv::Event &e);
+    std::size_t isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores) override;
+    void updateState(const dv::Event &e) override {updateQueues(e);}
+
     virtual std::string name() override {return "HARRIS";}
     virtual QWidget * customWidget() override {return nullptr;}
 
-    double getLastScore() const {
-      return lastScore_;
-    }
+    virtual Detector * newInstance() const override {return new HarrisDetector(lazyQueues_);}
+    virtual int supportRadius() const override {return windowSize_;}
 
   private:
     // methods
-    void updateQueue(const int x, const int y, const dv::Event &e);
     double getHarrisScore(int x, int y, bool polarity);
 
     // queues
-    LocalEventQueues* queues_;
+    DistinctQueue* queues_;
+    bool lazyQueues_;
 
     // parameters
     int queueSize_;
     int windowSize_;
     int kernelSize_;
-    static const int sensorWidth_  = 240;
-    static const int sensorHeight_ = 180;
     double harrisThreshold_;
 
-    double lastScore_;
-
     // kernels
     Eigen::MatrixXd Gx_, h_;
     int factorial(int n) const;
@@ -72,4 +80,6 @@ namespace dvsal{
 
 } // namespace
 
+#include "HarrisDetector.inl"
+
 #endif
\ No newline at end of file
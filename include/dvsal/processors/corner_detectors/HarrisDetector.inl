@@ -19,41 +19,29 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //---------------------------------------------------------------------------------------------------------------------
 
-#ifndef DVSAL_PROCESSORS_CORNERDETECTORS_FIXED_DISTINCT_QUEUE_H_
-#define DVSAL_PROCESSORS_CORNERDETECTORS_FIXED_DISTINCT_QUEUE_H_
+namespace dvsal{
 
-#include <deque>
-#include <vector>
-#include <Eigen/Dense>
+  inline bool HarrisDetector::isFeature(const dv::Event &e){
+    updateQueues(e);
+    return isCorner(e);
+  }
 
-namespace dvsal
-{
+  inline void HarrisDetector::updateQueues(const dv::Event &e){
+    queues_->newEvent(e.x(), e.y(), e.polarity());
+  }
 
-class FixedDistinctQueue{
-  
-  public:
-    FixedDistinctQueue(int window, int queue);
-
-    bool isFull() const;
-
-    void addNew(int x, int y);
-    Eigen::MatrixXi getWindow() const;
-
-  private:
-    // contains index of queue element if occupied, negative value otherwise
-    Eigen::MatrixXi window_;
-    // contains one event
-    struct QueueEvent
+  inline bool HarrisDetector::isCorner(const dv::Event &e){
+    // check if queue is full
+    double score = harrisThreshold_ - 10.;
+    if (queues_->isFull(e.x(), e.y(), e.polarity()))
     {
-      int prev, next;
-      int x, y;
-    };
-    std::vector<QueueEvent> queue_;
-    int first_, last_;
-    unsigned int queueMax_;
-  };
+      // check if current event is a feature
+      score = getHarrisScore(e.x(), e.y(), e.polarity());
 
+      lastScore_ = score;
+    }
 
-} // namespace
+    return (score > harrisThreshold_);
+  }
 
-#endif
\ No newline at end of file
+} // namespace
@@ -0,0 +1,44 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  CORNER DETECTOR https://github.com/uzh-rpg/rpg_corner_events
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2018
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without restriction,
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute,
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_CORNERDETECTORS_CIRCLE_OFFSETS_H_
+#define DVSAL_PROCESSORS_CORNERDETECTORS_CIRCLE_OFFSETS_H_
+
+namespace dvsal{
+
+  // pixel offsets of the circles of radius 3 and 4 used by the SAE based detectors, in order
+  // around the circle
+  struct CircleOffsets{
+    static constexpr int circle3[16][2] = {{0, 3}, {1, 3}, {2, 2}, {3, 1},
+                                           {3, 0}, {3, -1}, {2, -2}, {1, -3},
+                                           {0, -3}, {-1, -3}, {-2, -2}, {-3, -1},
+                                           {-3, 0}, {-3, 1}, {-2, 2}, {-1, 3}};
+
+    static constexpr int circle4[20][2] = {{0, 4}, {1, 4}, {2, 3}, {3, 2},
+                                           {4, 1}, {4, 0}, {4, -1}, {3, -2},
+                                           {2, -3}, {1, -4}, {0, -4}, {-1, -4},
+                                           {-2, -3}, {-3, -2}, {-4, -1}, {-4, 0},
+                                           {-4, 1}, {-3, 2}, {-2, 3}, {-1, 4}};
+  };
+
+} // namespace
+
+#endif
\ No newline at end of file
@@ -22,34 +22,97 @@
 #ifndef DVSAL_PROCESSORS_CORNERDETECTORS_DISTICT_QUEUES_H_
 #define DVSAL_PROCESSORS_CORNERDETECTORS_DISTICT_QUEUES_H_
 
-#include <deque>
+#include <cstdint>
+#include <vector>
 #include <Eigen/Dense>
 
+#include <dv-sdk/processing.hpp>
+
 #include <dvsal/processors/corner_detectors/utils/LocalEventQueues.h>
-#include <dvsal/processors/corner_detectors/utils/FixedDistinctQueue.h>
 
 namespace dvsal{
 
-  class DistinctQueue : public LocalEventQueues{
+  // Per-pixel queues of the most recent distinct events inside a (2*window+1)^2 neighbourhood.
+  //
+  // Every event at pixel E is pushed to the queue of each pixel P around it, so the queue of P
+  // always holds the queue_size most recently active pixels of its window. The queues are
+  // therefore fully described by the sequence number of the last event of every pixel plus the
+  // number of distinct pixels ever seen around P. Only those two values are stored per pixel:
+  // an event costs one store, plus one vectorizable counter update over its neighbourhood the
+  // first time its pixel fires. The patch of a pixel is rebuilt on demand by selecting the
+  // queue_size newest pixels of its window.
+  //
+  // The sensor is split in tiles of tileSize_ x tileSize_ pixels per polarity, each stored in
+  // an aligned page and found through an O(1) page table. By default all pages are carved from
+  // a single allocation. With lazy allocation a page is only materialized the first time an
+  // event touches it, so memory grows with the active area instead of the sensor resolution.
+  class DistinctQueue final : public LocalEventQueues{
     
   public:
-    DistinctQueue(int window_size, int queue_size, bool use_polarity);
+    DistinctQueue(int window_size, int queue_size, bool use_polarity,
+                  int sensor_width = 240, int sensor_height = 180, bool lazy_allocation = false);
     virtual ~DistinctQueue();
 
+    DistinctQueue(const DistinctQueue &) = delete;
+    DistinctQueue &operator=(const DistinctQueue &) = delete;
+
     void newEvent(int x, int y, bool pol=false);
     bool isFull(int x, int y, bool pol=false) const;
     Eigen::MatrixXi getPatch(int x, int y, bool pol=false);
 
+    // same as calling newEvent on each event in order
+    void newEvents(const dv::Event *events, std::size_t size);
+
+    // bytes currently held by queue pages
+    std::size_t allocatedBytes() const;
+
   private:
-    // data structure
-    std::vector<FixedDistinctQueue> queues_;
+    // count a first event at (x, y) in the queues around it
+    void touchNeighbourhood(int x, int y, bool pol);
+
+    // sequence number of the last event at (x, y), 0 if none or outside the sensor
+    uint64_t getStamp(int x, int y, bool pol) const;
+
+    // page table helpers
+    int getTile(int x, int y, bool polarity) const;
+    int getLocalIndex(int x, int y) const;
+    uint8_t *getPage(int tile);
+    void initPage(uint8_t *page) const;
+
+    // page sections
+    uint64_t *pageStamps(uint8_t *page) const { return reinterpret_cast<uint64_t*>(page); }
+    uint16_t *pageTouched(uint8_t *page) const { return reinterpret_cast<uint16_t*>(page + touchedOffset_); }
+
+    // page table and owned allocations
+    std::vector<uint8_t*> pages_;
+    std::vector<void*> blocks_;
+    bool lazyAllocation_;
+
+    // page layout
+    std::size_t pageBytes_;
+    std::size_t touchedOffset_;
+
+    int windowDim_;
+    int tilesX_;
+    int tilesY_;
+    bool usePolarity_;
+
+    int sensorWidth_;
+    int sensorHeight_;
+
+    // last assigned event sequence number
+    uint64_t sequence_;
 
-    // helper function
-    int getIndex(int x, int y, bool polarity) const;
+    // scratch space of getPatch
+    std::vector<uint64_t> patchStamps_;
+    std::vector<uint64_t> selection_;
 
     // constants
-    static const int sensorWidth_  = 240;
-    static const int sensorHeight_ = 180;
+    static const int tileShift_ = 4;
+    static const int tileSize_  = 1 << tileShift_;
+    static const int tileMask_  = tileSize_ - 1;
+    static const int tilePixels_ = tileSize_*tileSize_;
+    static const std::size_t pageAlignment_ = 64;
 };
 
 } // namespace
@@ -30,6 +30,7 @@ namespace dvsal{
     public:
       LocalEventQueues(int window_size, int queue_size)
       : window_size_(window_size), queue_size_(queue_size) {}
+      virtual ~LocalEventQueues() {}
 
       virtual void newEvent(int x, int y, bool pol) = 0;
       virtual bool isFull(int x, int y, bool pol) const = 0;
@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_CORNERDETECTORS_NON_MAX_SUPPRESSION_H_
+#define DVSAL_PROCESSORS_CORNERDETECTORS_NON_MAX_SUPPRESSION_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <dv-sdk/processing.hpp>
+
+namespace dvsal{
+
+  // Causal spatio-temporal non-maximum suppression of corners. A corner is kept unless a kept
+  // corner with a higher or equal score lies within _radius pixels and _timeWindow
+  // microseconds before it. Kept corners are stored in a grid of _radius x _radius buckets,
+  // each holding the kept corners of its area in time order, dropped once they leave the time
+  // window. A query only visits the 3x3 surrounding buckets.
+  class NonMaxSuppression{
+  public:
+    NonMaxSuppression(int _radius, int64_t _timeWindow, int _sensorWidth = 240, int _sensorHeight = 180);
+
+    // true if the corner is a local maximum, which then suppresses weaker corners around it
+    bool isMaximum(const dv::Event &_corner, double _score);
+
+    void reset();
+
+  private:
+    struct Entry{
+      int64_t timestamp;
+      double score;
+      int16_t x, y;
+    };
+
+    int radius_;
+    int64_t timeWindow_;
+    int bucketsX_;
+    int bucketsY_;
+    std::vector<std::vector<Entry>> buckets_;
+  };
+
+} // namespace
+
+#endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_FILTERS_BACKGROUND_ACTIVITY_FILTER_H_
+#define DVSAL_PROCESSORS_FILTERS_BACKGROUND_ACTIVITY_FILTER_H_
+
+#include <dvsal/processors/filters/EventFilter.h>
+
+#include <vector>
+
+namespace dvsal{
+
+  // Background activity filter: an event passes if any of its 8 neighbours fired, with any
+  // polarity, within the last _deltaT microseconds. Every event writes its timestamp to the
+  // cells of its neighbours and reads only its own cell, so the cost is one read and three
+  // short row writes. The grid keeps the low 32 bits of the timestamps and has a one pixel
+  // border, so no bound checks are needed. Timestamps wrap every ~71 minutes; a pixel whose
+  // neighbours stayed silent for that long may pass once.
+  class BackgroundActivityFilter : public EventFilter{
+    public:
+      BackgroundActivityFilter(int64_t _deltaT = 2000, int _width = 240, int _height = 180);
+
+      bool isValid(const dv::Event &e);
+      std::size_t isValidBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isValid) override;
+      std::size_t isValidBatch(const EventBatch &_batch, uint8_t *_isValid) override;
+
+      virtual std::string name() override {return "BACKGROUND-ACTIVITY";}
+
+      void reset();
+
+    private:
+      // isValid on the fields of one event, polarity is not used
+      bool check(int64_t _timestamp, int _x, int _y);
+
+    private:
+      uint32_t deltaT_;
+      int width_, height_;
+      int stride_;
+
+      // latest timestamp of a neighbour of every pixel
+      std::vector<uint32_t> grid_;
+      bool initialized_ = false;
+  };
+
+} // namespace
+
+#include "BackgroundActivityFilter.inl"
+
+#endif
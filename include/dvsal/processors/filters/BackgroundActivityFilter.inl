@@ -0,0 +1,49 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+namespace dvsal{
+
+  inline bool BackgroundActivityFilter::isValid(const dv::Event &e){
+    return check(e.timestamp(), e.x(), e.y());
+  }
+
+  inline bool BackgroundActivityFilter::check(int64_t _timestamp, int _x, int _y){
+    const uint32_t t = static_cast<uint32_t>(_timestamp);
+    if (!initialized_){
+      // no pixel has fired yet, make every cell older than deltaT_
+      grid_.assign(grid_.size(), t - deltaT_ - 1);
+      initialized_ = true;
+    }
+
+    uint32_t *cell = grid_.data() + (_y+1)*stride_ + _x+1;
+    const bool valid = uint32_t(t - *cell) <= deltaT_;
+
+    // the event supports its neighbours, not itself
+    uint32_t *above = cell - stride_;
+    uint32_t *below = cell + stride_;
+    above[-1] = above[0] = above[1] = t;
+    below[-1] = below[0] = below[1] = t;
+    cell[-1] = cell[1] = t;
+
+    return valid;
+  }
+
+} // namespace
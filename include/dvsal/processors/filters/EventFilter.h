@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_FILTERS_EVENT_FILTER_H_
+#define DVSAL_PROCESSORS_FILTERS_EVENT_FILTER_H_
+
+#include <dv-sdk/processing.hpp>
+
+#include <dvsal/utils/EventBatch.h>
+
+#include <cstdint>
+#include <string>
+
+namespace dvsal{
+
+  // Base of the event filters. A filter can run standalone through eventCallback or in front
+  // of a Detector, see Detector::addFilter.
+  class EventFilter{
+    public:
+      virtual ~EventFilter() {}
+
+      // check if the event passes the filter, updating the filter state
+      virtual bool isValid(const dv::Event &e) = 0;
+
+      // check a contiguous batch of events in order, _isValid[i] is set to 1 for events that
+      // pass and 0 otherwise. Returns the number of events that pass.
+      virtual std::size_t isValidBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isValid);
+
+      // same for a structure of arrays batch. The default converts the events back to structs,
+      // filters reading only some of the columns override it with a columnar loop.
+      virtual std::size_t isValidBatch(const EventBatch &_batch, uint8_t *_isValid);
+
+      virtual std::string name() = 0;
+
+      // interface
+      void eventCallback(const dv::EventStore &_msg);
+
+      // events of the last eventCallback that passed the filter
+      const dv::EventStore &filteredEvents() const {
+        return filteredEvents_;
+      }
+
+    protected:
+      // isValidBatch of a concrete filter, Filter_::isValid is resolved statically and inlined
+      template<typename Filter_>
+      static std::size_t batchLoop(Filter_ &_filter, const dv::Event *_events, std::size_t _size, uint8_t *_isValid){
+        std::size_t valid = 0;
+        for (std::size_t i = 0; i < _size; i++){
+          _isValid[i] = _filter.Filter_::isValid(_events[i]);
+          valid += _isValid[i];
+        }
+        return valid;
+      }
+
+    private:
+      dv::EventStore filteredEvents_;
+  };
+
+} // namespace
+
+#endif
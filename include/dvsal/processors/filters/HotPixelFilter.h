@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_FILTERS_HOT_PIXEL_FILTER_H_
+#define DVSAL_PROCESSORS_FILTERS_HOT_PIXEL_FILTER_H_
+
+#include <dvsal/processors/filters/EventFilter.h>
+
+#include <string>
+#include <vector>
+
+namespace dvsal{
+
+  // Drops the events of hot pixels and enforces a per pixel refractory period.
+  //
+  // While learning, events are counted per pixel over windows of _learningWindow
+  // microseconds. At the end of every window, pixels that fired at more than _maxRate Hz,
+  // i.e. strictly more than _maxRate * _learningWindow / 1e6 events in the window, are added
+  // to the hot pixel mask, which is a bitmap and is only cleared explicitly. Events of masked
+  // pixels are always dropped. Events closer than _refractoryPeriod microseconds to the last
+  // accepted event of the same pixel are dropped too, 0 disables the check.
+  class HotPixelFilter : public EventFilter{
+    public:
+      HotPixelFilter(double _maxRate = 1000.0, int64_t _learningWindow = 1000000, int64_t _refractoryPeriod = 0,
+                     int _width = 240, int _height = 180);
+
+      bool isValid(const dv::Event &e);
+      std::size_t isValidBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isValid) override;
+      std::size_t isValidBatch(const EventBatch &_batch, uint8_t *_isValid) override;
+
+      virtual std::string name() override {return "HOT-PIXEL";}
+
+      // enable or disable online learning of the mask, enabled by default
+      void setLearning(bool _learning);
+
+      bool isHot(int _x, int _y) const {
+        const std::size_t idx = std::size_t(_y)*width_ + _x;
+        return (mask_[idx >> 6] >> (idx & 63)) & 1;
+      }
+      void setHot(int _x, int _y);
+      std::size_t hotPixels() const;
+      void clearHotPixels();
+
+      // mask as a text file with the "x y" coordinates of one hot pixel per line
+      bool saveMask(const std::string &_path) const;
+      bool loadMask(const std::string &_path);
+
+    private:
+      // isValid on the fields of one event, polarity is not used
+      bool check(int64_t _timestamp, int _x, int _y);
+      void closeWindow();
+
+    private:
+      int width_, height_;
+      uint32_t hotCount_;   // smallest count over _maxRate in a window
+      int64_t learningWindow_;
+      uint32_t refractoryPeriod_;
+      bool learning_ = true;
+
+      std::vector<uint64_t> mask_;
+      std::vector<uint32_t> counts_;
+      std::vector<uint32_t> lastAccepted_;  // low 32 bits of the timestamps
+      std::vector<uint8_t> seen_;           // pixel has an accepted event, for the refractory check
+      int64_t windowStart_ = -1;
+  };
+
+} // namespace
+
+#include "HotPixelFilter.inl"
+
+#endif
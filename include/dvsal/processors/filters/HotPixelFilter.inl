@@ -0,0 +1,57 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+namespace dvsal{
+
+  inline bool HotPixelFilter::isValid(const dv::Event &e){
+    return check(e.timestamp(), e.x(), e.y());
+  }
+
+  inline bool HotPixelFilter::check(int64_t _timestamp, int _x, int _y){
+    if (learning_){
+      if (windowStart_ < 0)
+        windowStart_ = _timestamp;
+      else if (_timestamp - windowStart_ >= learningWindow_){
+        closeWindow();
+        windowStart_ = _timestamp;
+      }
+    }
+
+    const std::size_t idx = std::size_t(_y)*width_ + _x;
+    if ((mask_[idx >> 6] >> (idx & 63)) & 1){
+      return false;
+    }
+
+    if (learning_)
+      counts_[idx]++;
+
+    const uint32_t t = static_cast<uint32_t>(_timestamp);
+    if (refractoryPeriod_ > 0){
+      if (seen_[idx] && uint32_t(t - lastAccepted_[idx]) < refractoryPeriod_){
+        return false;
+      }
+      seen_[idx] = 1;
+      lastAccepted_[idx] = t;
+    }
+    return true;
+  }
+
+} // namespace
@@ -0,0 +1,78 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_SURFACES_EXPONENTIAL_TIME_SURFACE_H_
+#define DVSAL_PROCESSORS_SURFACES_EXPONENTIAL_TIME_SURFACE_H_
+
+#include <dvsal/processors/surfaces/TimeSurface.h>
+
+#include <opencv2/opencv.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace dvsal{
+
+  // Normalized time surface exp(-(t - SAE)/tau) for several decay constants at once. Only raw
+  // timestamps are stored, the decay is evaluated when reading: per pixel with value(), or
+  // over a whole frame with extract(), which writes tiles that did not fire within the decay
+  // cutoff as zeros without reading their pixels. Times are in microseconds, as event
+  // timestamps.
+  class ExponentialTimeSurface{
+    public:
+      // owns a TimeSurface updated by eventCallback
+      ExponentialTimeSurface(const std::vector<double> &_taus, int _width = 240, int _height = 180);
+
+      // reads a surface updated elsewhere (e.g. DetectorGroup::surface()), which must outlive it
+      ExponentialTimeSurface(const TimeSurface &_surface, const std::vector<double> &_taus);
+
+      // update the owned surface, does nothing when reading a shared one
+      void eventCallback(const dv::EventStore &_msg);
+
+      // decayed value of one pixel at _time with decay constant _taus[_tauIdx]
+      double value(int _x, int _y, bool _polarity, int64_t _time, std::size_t _tauIdx) const;
+
+      // CV_32F image (height x width) of the surface at _time
+      void extract(int64_t _time, std::size_t _tauIdx, bool _polarity, cv::Mat &_frame) const;
+
+      // values below _minValue are written as 0, 1e-3 by default
+      void setMinValue(double _minValue);
+
+      const std::vector<double> &taus() const {
+        return taus_;
+      }
+
+      const TimeSurface &surface() const {
+        return *surface_;
+      }
+
+    private:
+      std::unique_ptr<TimeSurface> ownSurface_;
+      const TimeSurface *surface_;
+
+      std::vector<double> taus_;      // seconds
+      std::vector<double> cutoffs_;   // age in seconds past which the value is below minValue_
+      double minValue_ = 1e-3;
+  };
+
+} // namespace
+
+#endif
@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_PROCESSORS_SURFACES_TIME_SURFACE_H_
+#define DVSAL_PROCESSORS_SURFACES_TIME_SURFACE_H_
+
+#include <dv-sdk/processing.hpp>
+
+#include <Eigen/Dense>
+
+#include <dvsal/utils/EventBatch.h>
+
+#include <vector>
+
+namespace dvsal{
+
+  // Surface of active events: latest timestamp, in seconds, of every pixel and polarity, 0 for
+  // pixels that never fired. One instance can be updated once per event and read by several
+  // processors, see DetectorGroup. The latest timestamp of every TileSize x TileSize tile is
+  // tracked too, so readers can skip regions that did not fire recently.
+  class TimeSurface{
+    public:
+      static const int TileSize = 16;
+
+      TimeSurface(int _width = 240, int _height = 180);
+
+      void update(const dv::Event &e);
+      void update(const dv::EventStore &_events);
+      void update(const EventBatch &_batch);
+      void reset();
+
+      // surface of one polarity, indexed (x, y)
+      const Eigen::MatrixXd &sae(bool _polarity) const {
+        return sae_[_polarity ? 1 : 0];
+      }
+
+      // both polarities, indexed as sae_[pol](x, y) like the detectors own surfaces
+      const Eigen::MatrixXd *sae() const {
+        return sae_;
+      }
+
+      double timestamp(int _x, int _y, bool _polarity) const {
+        return sae_[_polarity ? 1 : 0](_x, _y);
+      }
+
+      // latest timestamp of tile (_tx, _ty), 0 if none of its pixels fired
+      double tileLatest(int _tx, int _ty, bool _polarity) const {
+        return tileLatest_[_polarity ? 1 : 0][_ty*tilesX_ + _tx];
+      }
+
+      int width() const { return width_; }
+      int height() const { return height_; }
+      int tilesX() const { return tilesX_; }
+      int tilesY() const { return tilesY_; }
+
+    private:
+      int width_, height_;
+      int tilesX_, tilesY_;
+
+      Eigen::MatrixXd sae_[2];
+      std::vector<double> tileLatest_[2];
+      std::vector<double> seconds_;   // timestamps of the last EventBatch, in seconds
+  };
+
+} // namespace
+
+#include "TimeSurface.inl"
+
+#endif
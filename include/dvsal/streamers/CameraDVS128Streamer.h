@@ -35,24 +35,32 @@ namespace dvsal{
     class CameraDVS128Streamer : public Streamer{
     public:
         CameraDVS128Streamer(){};
-        ~CameraDVS128Streamer(){};
+        ~CameraDVS128Streamer(){ stopStreaming(); };
 
 		bool init();
 		void events(dv::EventStore &_events , int _microseconds);
         bool image(cv::Mat &_image); // Fake image using events
         bool step();
 
+        // lastEvents() holds the last packet only
+        bool nextPacket(dv::EventStore &_packet, std::size_t _maxEvents) override;
+        using Streamer::nextPacket;
+
         dv::EventStore lastEvents(){
             return lastEvents_;
         };
 
     private:
         static void usbShutdownHandler(void *_ptr) ;
+
+        // append every polarity event of the next container to _events, false on shutdown
+        bool acquire(dv::EventStore &_events);
     private:
         libcaer::devices::dvs128 *dvs128Handle_ = nullptr;        
         constexpr static std::atomic<bool> globalShutdown_{false};
 
         dv::EventStore lastEvents_;
+        dv::EventStore pending_;    // acquired but not returned by nextPacket yet
     };
 }
 
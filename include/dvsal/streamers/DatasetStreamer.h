@@ -27,16 +27,38 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace dvsal{
 
     class DatasetStreamer : public Streamer{
     public:
         DatasetStreamer(const std::string _string);
+        ~DatasetStreamer();
 
 		bool init();
         bool step();
 
+        // lastEvents() holds the last packet only
+        bool nextPacket(dv::EventStore &_packet, std::size_t _maxEvents) override;
+        using Streamer::nextPacket;
+
+        // Continue reading from the first event at or after _timestamp, in microseconds. Uses
+        // the seek index, loaded from <path>.idx or built and saved by a full pass the first
+        // time. Returns false if the file cannot be read.
+        bool seek(int64_t _timestamp);
+
+        // Parse the whole file at once, independently of the reading position. The mapped file
+        // is split at line breaks into chunks parsed concurrently on the ThreadPool, each into
+        // its own columns, which are then stitched in file order.
+        bool loadAll(std::vector<dv::Event> &_events);
+        bool loadAll(dv::EventStore &_events);
+        bool loadAll(EventBatch &_events);
+
+        // scan the whole file to build the seek index and save it to <path>.idx. Reading
+        // restarts from the beginning of the file afterwards.
+        bool buildIndex();
+
         void events(dv::EventStore &_events , int _microseconds);
         bool image(cv::Mat &_image);
 
@@ -44,9 +66,44 @@ namespace dvsal{
             return lastEvents_;
         };
         
+    private:
+        // next line of the file, without the line break, false at the end of the file
+        bool nextLine(const char *&_begin, const char *&_end);
+
+        // next event, _valid is false for malformed lines. False at the end of the file.
+        bool readEvent(dv::Event &_event, bool &_valid);
+
+        // parse the chunks of loadAll, in file order
+        bool parseChunks(std::vector<EventBatch> &_chunks);
+
+        // continue reading from byte _offset
+        bool rewind(uint64_t _offset);
+
+        // the index is valid only for the file size and modification time it was built for
+        bool loadIndex();
+        bool saveIndex() const;
+
     private:
         std::ifstream datasetFile_;
+        std::vector<char> buffer_;
+        std::size_t bufferBegin_ = 0;
+        std::size_t bufferEnd_ = 0;
+        bool endOfFile_ = false;
+        uint64_t bufferOffset_ = 0;     // file offset of buffer_[0]
         std::string datasetPath_;
+
+        // sparse seek index, an entry every IndexEvents events or IndexInterval microseconds
+        struct IndexEntry{
+            int64_t timestamp;          // of the first event at offset
+            uint64_t offset;
+        };
+        static const std::size_t IndexEvents = 10000;
+        static const int64_t IndexInterval = 100000;
+
+        std::vector<IndexEntry> index_;
+        bool indexComplete_ = false;
+        bool indexing_ = false;         // reading sequentially from the start, index built on the way
+        std::size_t eventsSinceEntry_ = 0;
         
         dv::EventStore lastEvents_;
 
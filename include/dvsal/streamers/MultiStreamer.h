@@ -0,0 +1,94 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef MULTI_STREAMER_H_
+#define MULTI_STREAMER_H_
+
+#include <dvsal/streamers/Streamer.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace dvsal{
+
+    // Merge of several streamers into one stream ordered by timestamp. Every source must be
+    // ordered itself. Sources are read with nextPacket in packets of _sourceBatch events and
+    // merged with a heap keyed by the next timestamp of each source; events are copied in
+    // runs, up to the next timestamp of the other sources, not one heap operation per event.
+    //
+    // A live source can have no events at a given time. While a source is idle, events of the
+    // others are only released up to _reorderWindow microseconds before the newest timestamp
+    // seen, which bounds both the latency and how late that source's events can arrive.
+    //
+    // Sources are not owned and must outlive the merge. Use nextPacket, the source of every
+    // event of the last packet is given by lastSourceIds().
+    class MultiStreamer : public Streamer{
+    public:
+        MultiStreamer(const std::vector<Streamer *> &_sources, int64_t _reorderWindow = 10000, std::size_t _sourceBatch = 4096);
+        ~MultiStreamer();
+
+        bool init();
+        bool step();
+
+        bool nextPacket(dv::EventStore &_packet, std::size_t _maxEvents) override;
+        using Streamer::nextPacket;
+
+        void events(dv::EventStore &_events , int _microseconds);
+        bool image(cv::Mat &_image);
+
+        dv::EventStore lastEvents(){
+            return lastEvents_;
+        };
+
+        // index in the sources of every event of the last packet
+        const std::vector<uint16_t> &lastSourceIds() const {
+            return sourceIds_;
+        }
+
+    private:
+        struct Source{
+            Streamer *streamer;
+            std::vector<dv::Event> events;  // reused between packets
+            std::size_t next = 0;
+            bool alive = true;
+            bool queued = false;            // in the heap
+        };
+
+        // read the next packet of an exhausted source and queue it, if it has events
+        void refill(std::size_t _idx);
+        void pushHeap(std::size_t _idx);
+
+    private:
+        std::vector<Source> sources_;
+        // (next timestamp, source), smallest first
+        std::vector<std::pair<int64_t, std::size_t>> heap_;
+
+        int64_t reorderWindow_;
+        std::size_t sourceBatch_;
+        int64_t newest_ = INT64_MIN;
+
+        dv::EventStore lastEvents_;
+        std::vector<uint16_t> sourceIds_;
+    };
+
+}
+
+#endif
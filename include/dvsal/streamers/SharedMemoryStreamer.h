@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef SHARED_MEMORY_STREAMER_H_
+#define SHARED_MEMORY_STREAMER_H_
+
+#include <dvsal/streamers/Streamer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dvsal{
+
+    // Layout of the shared segment: a header followed by a ring of capacity events. Event i
+    // of the stream lives in slot i % capacity. The writer first advances reserveIndex, then
+    // writes the slots and finally advances writeIndex, so readers validate what they copied
+    // like with a seqlock: slots below reserveIndex - capacity may have been overwritten.
+    // publisherPid lets readers notice a publisher that died without closing the ring.
+    struct SharedEventRing{
+        uint32_t magic;
+        uint32_t eventSize;
+        uint64_t capacity;
+        int64_t publisherPid;
+        std::atomic<uint64_t> reserveIndex;
+        std::atomic<uint64_t> writeIndex;
+        std::atomic<uint64_t> packets;
+        std::atomic<uint32_t> closed;
+    };
+
+    // Publishes packets to a POSIX shared memory segment, e.g. as the sink of a Pipeline or
+    // the callback of Streamer::startStreaming. The writer never waits for readers, so the
+    // cost does not depend on how many SharedMemoryStreamers are attached; readers that
+    // fall more than a ring behind lose events.
+    class SharedMemoryPublisher{
+    public:
+        // _name is the segment name, e.g. "/dvsal_camera". _capacity, in events, is rounded
+        // up to a power of two.
+        SharedMemoryPublisher(const std::string &_name, std::size_t _capacity = 1 << 20);
+        ~SharedMemoryPublisher();
+
+        SharedMemoryPublisher(const SharedMemoryPublisher &) = delete;
+        SharedMemoryPublisher &operator=(const SharedMemoryPublisher &) = delete;
+
+        // create the segment, replacing an existing one with the same name. The replaced ring is
+        // marked closed first, so readers still mapped to it stop instead of waiting forever.
+        bool init();
+
+        void publish(const dv::EventStore &_events);
+
+        // tell the readers the stream ended and remove the segment
+        void close();
+
+    private:
+        std::string name_;
+        std::size_t capacity_;
+        std::size_t bytes_ = 0;
+        SharedEventRing *ring_ = nullptr;
+        dv::Event *events_ = nullptr;
+    };
+
+    // Reads the packets of a SharedMemoryPublisher from another process, starting from the
+    // newest event at init. nextPacket skips the events already overwritten, copies the rest
+    // out of the ring once, straight into the packet, then validates them against the writer
+    // and drops those overwritten meanwhile, see overruns().
+    class SharedMemoryStreamer : public Streamer{
+    public:
+        SharedMemoryStreamer(const std::string &_name);
+        ~SharedMemoryStreamer();
+
+        bool init();
+        bool step();
+
+        // waits for new events, returns false once the ring is drained and the publisher closed
+        // it, was replaced by a new publisher or is no longer running. The publisher must run
+        // in the same PID namespace as the readers.
+        bool nextPacket(dv::EventStore &_packet, std::size_t _maxEvents) override;
+        using Streamer::nextPacket;
+
+        void events(dv::EventStore &_events , int _microseconds);
+        bool image(cv::Mat &_image);
+
+        dv::EventStore lastEvents(){
+            return lastEvents_;
+        };
+
+        // stream index of the next event to read
+        uint64_t sequence() const {
+            return readIndex_;
+        }
+
+        // events lost because the reader fell more than a ring behind
+        uint64_t overruns() const {
+            return overruns_;
+        }
+
+    private:
+        std::string name_;
+        std::size_t bytes_ = 0;
+        const SharedEventRing *ring_ = nullptr;
+        const dv::Event *events_ = nullptr;
+
+        uint64_t readIndex_ = 0;
+        uint64_t overruns_ = 0;
+        dv::EventStore lastEvents_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef SOCKET_STREAMER_H_
+#define SOCKET_STREAMER_H_
+
+#include <dvsal/streamers/Streamer.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dvsal{
+
+    // Binary event packets over a stream socket. Every packet is a header followed by its
+    // events, little endian:
+    //
+    //      uint32 magic, uint32 number of events
+    //      number of events x { int64 timestamp, int16 x, int16 y, uint8 polarity, 3 bytes padding }
+    //
+    // Addresses are "unix:<path>" for Unix domain sockets or "<ipv4>:<port>" for TCP, e.g.
+    // "127.0.0.1:7777". Any producer writing this format can feed a SocketStreamer.
+    struct SocketEvent{
+        int64_t timestamp;
+        int16_t x, y;
+        uint8_t polarity;
+        uint8_t padding[3];
+    };
+
+    // Sends packets to a SocketStreamer, one scatter-gather write per packet.
+    class SocketSender{
+    public:
+        SocketSender(const std::string &_address);
+        ~SocketSender();
+
+        SocketSender(const SocketSender &) = delete;
+        SocketSender &operator=(const SocketSender &) = delete;
+
+        // connect to the streamer, which must be listening
+        bool init();
+
+        // false if the connection was lost
+        bool send(const dv::EventStore &_events);
+
+        void close();
+
+    private:
+        std::string address_;
+        int socket_ = -1;
+        std::vector<SocketEvent> buffer_;
+    };
+
+    // Listens on an address and streams the packets of the first producer that connects.
+    class SocketStreamer : public Streamer{
+    public:
+        SocketStreamer(const std::string &_address);
+        ~SocketStreamer();
+
+        // bind and listen, the producer is accepted by the first read
+        bool init();
+        bool step();
+
+        // blocks until some events are available, returns the events already received up to
+        // _maxEvents without waiting for more. False once the producer disconnected.
+        bool nextPacket(dv::EventStore &_packet, std::size_t _maxEvents) override;
+        using Streamer::nextPacket;
+
+        void events(dv::EventStore &_events , int _microseconds);
+        bool image(cv::Mat &_image);
+
+        dv::EventStore lastEvents(){
+            return lastEvents_;
+        };
+
+    private:
+        // read what the socket has, blocking if _wait. False on disconnection.
+        bool fill(bool _wait);
+
+    private:
+        std::string address_;
+        int listener_ = -1;
+        int socket_ = -1;
+
+        std::vector<char> buffer_;
+        std::size_t bufferBegin_ = 0;
+        std::size_t bufferEnd_ = 0;
+        uint32_t packetRemaining_ = 0;  // events of the current packet not read yet
+        bool connected_ = true;
+
+        dv::EventStore lastEvents_;
+    };
+
+}
+
+#endif
@@ -24,6 +24,12 @@
 
 #include <string>
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
 
 #include <dv-sdk/processing.hpp>
 #include <dv-sdk/config.hpp>
@@ -31,6 +37,8 @@
 
 #include <opencv2/opencv.hpp>
 
+#include <dvsal/utils/EventBatch.h>
+
 namespace dvsal{
 
   class Streamer{
@@ -38,7 +46,7 @@ namespace dvsal{
     template<typename _Type, typename... _T>
     static Streamer *create( _T&&... _arg);
     
-    virtual ~Streamer() {};
+    virtual ~Streamer() { stopStreaming(); };
 
   public:
     
@@ -50,6 +58,56 @@ namespace dvsal{
 
     virtual dv::EventStore lastEvents() = 0;
 
+    // Pull the next packet of at most _maxEvents events, calling step() as needed. Returns
+    // false once the stream is exhausted, _packet then holds the remaining events, if any.
+    // Hands out lastEvents() past the events already returned, so it should not be mixed
+    // with events(), which slices lastEvents(). _maxEvents must be positive, 0 is rejected
+    // with an empty packet and false.
+    virtual bool nextPacket(dv::EventStore &_packet, std::size_t _maxEvents);
+
+    // same, converted to a structure of arrays batch
+    bool nextPacket(EventBatch &_batch, std::size_t _maxEvents);
+
+    typedef std::function<void(const dv::EventStore &)> PacketCallback;
+
+    // Next packet of at most _maxEvents events as a future, acquired on another thread. The
+    // packet is empty once the stream is exhausted. Packets are acquired one at a time in the
+    // order of the calls, so with several futures in flight each one holds the packet that
+    // follows the previous one and they complete in the order they were requested. The
+    // acquisition uses the streamer, which waits for the pending ones in stopStreaming(), so
+    // destroying the streamer blocks until they finish.
+    std::future<dv::EventStore> nextPacketAsync(std::size_t _maxEvents);
+
+    // Acquire packets of at most _maxEvents events on a dedicated thread and pass each one to
+    // _callback, from that thread, as soon as it is ready. _onEnd is called once the stream is
+    // exhausted. Returns false if already streaming or _maxEvents is 0. Not to be mixed with the
+    // other pull calls.
+    bool startStreaming(PacketCallback _callback, std::size_t _maxEvents, std::function<void()> _onEnd = nullptr);
+
+    // wait for the packets being acquired, by the streaming thread or by nextPacketAsync, and
+    // stop the thread. Streamers call it from their destructor, so that no acquisition ever
+    // sees a partially destroyed streamer.
+    void stopStreaming();
+
+    bool isStreaming() const {
+      return streaming_;
+    }
+
+  protected:
+    std::size_t consumed_ = 0;
+
+  private:
+    std::mutex acquireMutex_;
+    std::thread streamingThread_;
+    std::atomic<bool> streaming_{false};
+
+    // acquisitions of nextPacketAsync not finished yet. Every call takes the next ticket and
+    // acquires once asyncServing_ reaches it.
+    std::mutex asyncMutex_;
+    std::condition_variable asyncDone_;
+    std::size_t asyncPending_ = 0;
+    uint64_t asyncTickets_ = 0;
+    uint64_t asyncServing_ = 0;
   };    
 }
 
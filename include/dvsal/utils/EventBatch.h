@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_UTILS_EVENT_BATCH_H_
+#define DVSAL_UTILS_EVENT_BATCH_H_
+
+#include <dv-sdk/processing.hpp>
+
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace dvsal{
+
+  // allocator of Alignment_ aligned storage, so columns can be loaded as aligned SIMD vectors
+  template<typename Type_, std::size_t Alignment_ = 64>
+  struct AlignedAllocator{
+    typedef Type_ value_type;
+    template<typename Other_> struct rebind{ typedef AlignedAllocator<Other_, Alignment_> other; };
+
+    AlignedAllocator() = default;
+    template<typename Other_> AlignedAllocator(const AlignedAllocator<Other_, Alignment_> &) {}
+
+    Type_ *allocate(std::size_t _size){
+      return static_cast<Type_ *>(::operator new(_size*sizeof(Type_), std::align_val_t(Alignment_)));
+    }
+    void deallocate(Type_ *_ptr, std::size_t){
+      ::operator delete(_ptr, std::align_val_t(Alignment_));
+    }
+
+    template<typename Other_> bool operator==(const AlignedAllocator<Other_, Alignment_> &) const { return true; }
+    template<typename Other_> bool operator!=(const AlignedAllocator<Other_, Alignment_> &) const { return false; }
+  };
+
+  // Events as a structure of arrays: timestamp, x and y columns aligned to 64 bytes and the
+  // polarities as a bitplane, bit i%64 of word i/64. Kernels iterating a column can load
+  // several events per SIMD register, which dv::EventStore, an array of 16 byte structs,
+  // does not allow.
+  class EventBatch{
+    public:
+      template<typename Type_>
+      using Column = std::vector<Type_, AlignedAllocator<Type_>>;
+
+      EventBatch() = default;
+      explicit EventBatch(const dv::EventStore &_events);
+
+      void assign(const dv::EventStore &_events);
+      void assign(const dv::Event *_events, std::size_t _size);
+
+      dv::EventStore toEventStore() const;
+      void toEvents(std::vector<dv::Event> &_events) const;
+
+      void reserve(std::size_t _size);
+      void resize(std::size_t _size);
+      void clear();
+      void push_back(const dv::Event &e);
+
+      std::size_t size() const { return timestamps_.size(); }
+      bool empty() const { return timestamps_.empty(); }
+
+      int64_t *timestamps() { return timestamps_.data(); }
+      const int64_t *timestamps() const { return timestamps_.data(); }
+      int16_t *xs() { return xs_.data(); }
+      const int16_t *xs() const { return xs_.data(); }
+      int16_t *ys() { return ys_.data(); }
+      const int16_t *ys() const { return ys_.data(); }
+      uint64_t *polarities() { return polarities_.data(); }
+      const uint64_t *polarities() const { return polarities_.data(); }
+
+      bool polarity(std::size_t _idx) const {
+        return (polarities_[_idx >> 6] >> (_idx & 63)) & 1;
+      }
+      void setPolarity(std::size_t _idx, bool _polarity){
+        const uint64_t bit = uint64_t(1) << (_idx & 63);
+        polarities_[_idx >> 6] = _polarity ? polarities_[_idx >> 6] | bit : polarities_[_idx >> 6] & ~bit;
+      }
+
+      dv::Event event(std::size_t _idx) const {
+        return dv::Event(timestamps_[_idx], xs_[_idx], ys_[_idx], polarity(_idx));
+      }
+
+    private:
+      Column<int64_t> timestamps_;
+      Column<int16_t> xs_;
+      Column<int16_t> ys_;
+      Column<uint64_t> polarities_;
+  };
+
+} // namespace
+
+#endif
@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_UTILS_EVENT_CODEC_H_
+#define DVSAL_UTILS_EVENT_CODEC_H_
+
+#include <dv-sdk/processing.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace dvsal{
+
+  // Compressed in-memory store of events, for history buffers and recordings.
+  //
+  // Events are encoded in independent blocks of up to BlockSize events. Inside a block every
+  // field is frame-of-reference bit packed: timestamp deltas minus the smallest delta, x and
+  // y minus their minimum, each with the bits its range needs, and polarities as a bitplane.
+  // Blocks start on a 64 bit word and are indexed by their first timestamp, so any block can
+  // be decoded on its own. Ordered streams of a 240x180 sensor take around 20 bits per event
+  // instead of 128.
+  class EventCodec{
+    public:
+      static constexpr std::size_t BlockSize = 1024;
+
+      struct Block{
+        int64_t firstTimestamp;
+        int64_t minDelta;
+        uint64_t offset;      // first word of the block
+        uint32_t size;
+        uint8_t deltaBits, xBits, yBits;
+        int16_t xMin, yMin;
+      };
+
+      // encode and append events, which start a new block
+      void append(const dv::Event *_events, std::size_t _size);
+      void append(const dv::EventStore &_events);
+
+      // decode every event
+      void decode(dv::EventStore &_events) const;
+      void decode(std::vector<dv::Event> &_events) const;
+
+      // decode block _idx to _events, which must hold block(_idx).size events. Returns the size.
+      std::size_t decodeBlock(std::size_t _idx, dv::Event *_events) const;
+
+      // index of the last block starting at or before _timestamp, 0 if none
+      std::size_t findBlock(int64_t _timestamp) const;
+
+      std::size_t blockCount() const { return blocks_.size(); }
+      const Block &block(std::size_t _idx) const { return blocks_[_idx]; }
+
+      // number of events
+      std::size_t size() const { return size_; }
+
+      // bytes used by the encoded events and the block index
+      std::size_t bytes() const { return data_.size()*sizeof(uint64_t) + blocks_.size()*sizeof(Block); }
+
+      void clear();
+
+      // binary recording, false on error
+      bool write(std::ostream &_stream) const;
+      bool read(std::istream &_stream);
+
+    private:
+      void appendBlock(const dv::Event *_events, std::size_t _size);
+      void putBits(uint64_t _value, int _bits);
+
+    private:
+      std::vector<Block> blocks_;
+      std::vector<uint64_t> data_;
+      uint64_t bitPos_ = 0;
+      std::size_t size_ = 0;
+  };
+
+} // namespace
+
+#endif
@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#ifndef DVSAL_UTILS_THREAD_POOL_H_
+#define DVSAL_UTILS_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dvsal{
+
+  // Work-stealing thread pool. Every worker owns a deque: tasks submitted from a worker go to
+  // the back of its own deque and are run LIFO, idle workers steal from the front of the
+  // others. Tasks are submitted and joined through a TaskGroup, whose wait() runs pending
+  // tasks instead of blocking, so tasks can submit and wait for subtasks without deadlock.
+  //
+  // dvsal code submits to ThreadPool::global(), shared by every processor and streamer of
+  // the process so several pipelines do not oversubscribe the cores.
+  class ThreadPool{
+    public:
+      class TaskGroup;
+
+      ThreadPool(std::size_t _threads);
+      ~ThreadPool();
+
+      ThreadPool(const ThreadPool &) = delete;
+      ThreadPool &operator=(const ThreadPool &) = delete;
+
+      // Process wide pool, created on first use with as many workers as the DVSAL_THREADS
+      // environment variable or, if unset, std::thread::hardware_concurrency().
+      static ThreadPool &global();
+
+      // set the size of the global pool, false if it was already created
+      static bool configureGlobal(std::size_t _threads);
+
+      std::size_t size() const {
+        return workers_.size();
+      }
+
+    private:
+      struct Worker{
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::thread thread;
+      };
+
+      void submit(std::function<void()> _task);
+
+      // run one queued task, taken from the own deque first, then stolen. False if none.
+      bool runOne();
+      void workerLoop(std::size_t _idx);
+
+    private:
+      std::vector<std::unique_ptr<Worker>> workers_;
+      std::atomic<std::size_t> queued_{0};
+      std::atomic<std::size_t> nextWorker_{0};
+      std::mutex wakeMutex_;
+      std::condition_variable wake_;
+      bool stop_ = false;
+  };
+
+  // Set of tasks joined together. The destructor waits for them.
+  //
+  //    dvsal::ThreadPool::TaskGroup group;
+  //    for (auto &tile : tiles)
+  //      group.run([&tile](){ process(tile); });
+  //    group.wait();
+  class ThreadPool::TaskGroup{
+    public:
+      TaskGroup(ThreadPool &_pool = ThreadPool::global());
+      ~TaskGroup();
+
+      TaskGroup(const TaskGroup &) = delete;
+      TaskGroup &operator=(const TaskGroup &) = delete;
+
+      void run(std::function<void()> _task);
+
+      // run queued tasks until every task of the group is done, then rethrow the first
+      // exception thrown by one of them, if any
+      void wait();
+
+    private:
+      ThreadPool &pool_;
+      std::atomic<std::size_t> pending_{0};
+      std::mutex mutex_;
+      std::condition_variable done_;
+      std::exception_ptr error_;
+  };
+
+} // namespace
+
+#endif
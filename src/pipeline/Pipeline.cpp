@@ -0,0 +1,177 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/pipeline/Pipeline.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace dvsal{
+
+  namespace{
+    void pinThread(std::thread &_thread, int _cpu){
+      if (_cpu < 0){
+        return;
+      }
+#ifdef __linux__
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(_cpu, &set);
+      if (pthread_setaffinity_np(_thread.native_handle(), sizeof(cpu_set_t), &set) != 0){
+        std::cout << "Could not pin pipeline thread to cpu " << _cpu << std::endl;
+      }
+#else
+      std::cout << "Thread pinning not supported on this platform" << std::endl;
+#endif
+    }
+  }
+
+  Pipeline::Pipeline(Streamer *_streamer, std::size_t _batchSize, std::size_t _queueCapacity) :
+      streamer_(_streamer), batchSize_(_batchSize > 0 ? _batchSize : 1), queueCapacity_(_queueCapacity){
+  }
+
+  Pipeline::~Pipeline(){
+    stop();
+  }
+
+  void Pipeline::addStage(const std::string &_name, StageFunction _function, int _cpu){
+    std::unique_ptr<Stage> stage(new Stage());
+    stage->name = _name;
+    stage->function = std::move(_function);
+    stage->cpu = _cpu;
+    stages_.push_back(std::move(stage));
+  }
+
+  void Pipeline::addFilter(EventFilter *_filter, int _cpu){
+    addStage(_filter->name(), [_filter](dv::EventStore &_packet){
+      _filter->eventCallback(_packet);
+      _packet = _filter->filteredEvents();
+      return !_packet.isEmpty();
+    }, _cpu);
+  }
+
+  void Pipeline::addDetector(Detector *_detector, int _cpu){
+    // corners go to a buffer owned by the stage, so a corner sink set on the detector does
+    // not empty the packets, and the buffer is reused across packets
+    addStage(_detector->name(), [_detector, corners = std::vector<dv::Event>()](dv::EventStore &_packet) mutable {
+      _detector->eventCallback(_packet, corners);
+      dv::EventStore packet;
+      for (const auto &corner : corners){
+        packet.add(corner);
+      }
+      _packet = packet;
+      return !_packet.isEmpty();
+    }, _cpu);
+  }
+
+  void Pipeline::addSink(SinkFunction _sink, int _cpu){
+    addStage("sink", [_sink](dv::EventStore &_packet){
+      _sink(_packet);
+      return true;
+    }, _cpu);
+  }
+
+  void Pipeline::setStreamerAffinity(int _cpu){
+    streamerCpu_ = _cpu;
+  }
+
+  bool Pipeline::start(){
+    if (running_ || !threads_.empty()){
+      return false;
+    }
+    running_ = true;
+
+    queues_.clear();
+    for (std::size_t i = 0; i < stages_.size(); i++){
+      queues_.emplace_back(new BoundedQueue<dv::EventStore>(queueCapacity_));
+    }
+
+    threads_.emplace_back(&Pipeline::sourceLoop, this);
+    pinThread(threads_.back(), streamerCpu_);
+    for (std::size_t i = 0; i < stages_.size(); i++){
+      threads_.emplace_back(&Pipeline::stageLoop, this, i);
+      pinThread(threads_.back(), stages_[i]->cpu);
+    }
+    return true;
+  }
+
+  void Pipeline::wait(){
+    join();
+  }
+
+  void Pipeline::stop(){
+    running_ = false;
+    for (auto &queue : queues_){
+      queue->close();
+    }
+    join();
+  }
+
+  void Pipeline::join(){
+    for (auto &thread : threads_){
+      if (thread.joinable())
+        thread.join();
+    }
+    threads_.clear();
+    running_ = false;
+  }
+
+  void Pipeline::sourceLoop(){
+    while (running_){
+      dv::EventStore packet;
+      const bool more = streamer_->nextPacket(packet, batchSize_);
+      if (!packet.isEmpty() && !queues_.empty()){
+        if (!queues_[0]->push(std::move(packet)))
+          break;
+      }
+      if (!more)
+        break;
+    }
+
+    // closing lets the stages drain what is queued and finish in order
+    if (!queues_.empty()){
+      queues_[0]->close();
+    }
+  }
+
+  void Pipeline::stageLoop(std::size_t _idx){
+    Stage &stage = *stages_[_idx];
+    BoundedQueue<dv::EventStore> *next = _idx + 1 < queues_.size() ? queues_[_idx + 1].get() : nullptr;
+
+    dv::EventStore packet;
+    while (queues_[_idx]->pop(packet)){
+      if (!running_)
+        break;
+      if (!stage.function(packet))
+        continue;
+      stage.packets++;
+      if (next != nullptr && !next->push(std::move(packet)))
+        break;
+    }
+
+    if (next != nullptr){
+      next->close();
+    }
+  }
+
+} // namespace
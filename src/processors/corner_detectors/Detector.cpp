@@ -21,6 +21,11 @@
 
 #include <dvsal/processors/corner_detectors/Detector.h>
 
+#include <algorithm>
+#include <chrono>
+
+#include <dvsal/utils/ThreadPool.h>
+
 namespace dvsal{
 
   Detector::Detector(){
@@ -31,17 +36,295 @@ namespace dvsal{
 
   void Detector::eventCallback(const dv::EventStore &_msg){
 
-    dv::EventStore feature_msg;
+    batch_.assign(_msg.begin(), _msg.end());
+    detect();
+
+    if (cornerSink_){
+      for (std::size_t i = 0; i < batch_.size(); i++){
+        if (isCorner_[i])
+          cornerSink_(batch_[i], scores_[i]);
+      }
+      return;
+    }
 
-    for (const auto e : _msg){
-  
-      if (isFeature(e)) // call to FAST or Harris
-        feature_msg.add(e);
-      
+    dv::EventStore feature_msg;
+    cornerScores_.clear();
+    for (std::size_t i = 0; i < batch_.size(); i++){
+      if (isCorner_[i]){
+        feature_msg.add(batch_[i]);
+        cornerScores_.push_back(scores_[i]);
+      }
     }
     // publish feature events
     cornersDetected_ = feature_msg;
 
   }
 
+  void Detector::eventCallback(const dv::EventStore &_msg, std::vector<dv::Event> &_corners){
+
+    batch_.assign(_msg.begin(), _msg.end());
+    detect();
+
+    _corners.clear();
+    for (std::size_t i = 0; i < batch_.size(); i++){
+      if (isCorner_[i])
+        _corners.push_back(batch_[i]);
+    }
+  }
+
+  void Detector::eventCallback(const dv::EventStore &_msg, std::vector<dv::Event> &_corners, std::vector<double> &_scores){
+
+    batch_.assign(_msg.begin(), _msg.end());
+    detect();
+
+    _corners.clear();
+    _scores.clear();
+    for (std::size_t i = 0; i < batch_.size(); i++){
+      if (isCorner_[i]){
+        _corners.push_back(batch_[i]);
+        _scores.push_back(scores_[i]);
+      }
+    }
+  }
+
+  void Detector::setCornerSink(CornerSink _sink){
+    cornerSink_ = std::move(_sink);
+    cornersDetected_ = dv::EventStore();
+    cornerScores_.clear();
+  }
+
+  void Detector::enableNonMaxSuppression(int _radius, int64_t _timeWindow){
+    nonMaxSuppression_.reset(new NonMaxSuppression(_radius, _timeWindow, sensorWidth_, sensorHeight_));
+  }
+
+  void Detector::disableNonMaxSuppression(){
+    nonMaxSuppression_.reset();
+  }
+
+  void Detector::addFilter(EventFilter *_filter){
+    filters_.push_back(_filter);
+  }
+
+  void Detector::clearFilters(){
+    filters_.clear();
+  }
+
+  void Detector::enableLoadShedding(int64_t _budget){
+    sheddingBudget_ = std::max<int64_t>(_budget, 0);
+  }
+
+  void Detector::disableLoadShedding(){
+    sheddingBudget_ = 0;
+  }
+
+  void Detector::detect(){
+    // drop the events rejected by any filter, keeping the order
+    for (auto filter : filters_){
+      isCorner_.resize(batch_.size());
+      filter->isValidBatch(batch_.data(), batch_.size(), isCorner_.data());
+
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < batch_.size(); i++){
+        if (isCorner_[i])
+          batch_[kept++] = batch_[i];
+      }
+      batch_.resize(kept);
+    }
+
+    isCorner_.resize(batch_.size());
+    scores_.resize(batch_.size());
+
+    if (!tiles_.empty()){
+      parallelDetect();
+    }
+    else if (sheddingBudget_ > 0){
+      sheddingDetect();
+    }
+    else{
+      isFeatureBatch(batch_.data(), batch_.size(), isCorner_.data(), scores_.data()); // call to FAST or Harris
+    }
+
+    // suppression runs on the merged corners, in event order
+    if (nonMaxSuppression_){
+      for (std::size_t i = 0; i < batch_.size(); i++){
+        if (isCorner_[i] && !nonMaxSuppression_->isMaximum(batch_[i], scores_[i]))
+          isCorner_[i] = 0;
+      }
+    }
+  }
+
+  std::size_t Detector::isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores){
+    std::size_t corners = 0;
+    for (std::size_t i = 0; i < _size; i++){
+      _isCorner[i] = isFeature(_events[i]);
+      if (_scores != nullptr && _isCorner[i])
+        _scores[i] = lastScore_;
+      corners += _isCorner[i];
+    }
+    return corners;
+  }
+
+  void Detector::sheddingDetect(){
+    // one event out of samplePeriod is timed to follow the cost of both paths
+    const std::size_t samplePeriod = 32;
+    const double alpha = 0.1;
+
+    const std::size_t n = batch_.size();
+    const double budget = sheddingBudget_ * 0.000001;
+
+    // plan: nFull events scored, nKept - nFull only updated, the rest dropped. Until
+    // updateState has been measured it is assumed to be ten times cheaper than scoring.
+    std::size_t nFull = n;
+    std::size_t nKept = n;
+    const double fullCost = fullCost_;
+    const double updateCost = updateCost_ > 0.0 ? updateCost_ : fullCost_ * 0.1;
+    if (fullCost > 0.0 && n*fullCost > budget){
+      if (n*updateCost <= budget){
+        nFull = fullCost > updateCost ? std::min<std::size_t>(n, (budget - n*updateCost) / (fullCost - updateCost)) : 0;
+      }
+      else{
+        nFull = 0;
+        nKept = updateCost > 0.0 ? std::min<std::size_t>(n, budget / updateCost) : n;
+      }
+    }
+
+    for (std::size_t i = 0; i < n; i++){
+      const dv::Event &e = batch_[i];
+      isCorner_[i] = 0;
+
+      // event i is selected when the running count of a spread of k events over n steps advances
+      const bool full = (i+1)*nFull/n > i*nFull/n;
+      const bool kept = (i+1)*nKept/n > i*nKept/n;
+      if (!kept){
+        sheddingStats_.dropped++;
+        continue;
+      }
+
+      const bool sample = i % samplePeriod == 0;
+      std::chrono::steady_clock::time_point t0;
+      if (sample){
+        t0 = std::chrono::steady_clock::now();
+      }
+
+      if (full){
+        isCorner_[i] = isFeature(e);
+        if (isCorner_[i])
+          scores_[i] = lastScore_;
+        sheddingStats_.processed++;
+      }
+      else{
+        updateState(e);
+        sheddingStats_.updatedOnly++;
+      }
+
+      if (sample){
+        const double cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        double &estimate = full ? fullCost_ : updateCost_;
+        estimate = estimate > 0.0 ? (1.0 - alpha)*estimate + alpha*cost : cost;
+      }
+    }
+  }
+
+  bool Detector::enableParallelMode(int _tilesX, int _tilesY){
+    const int radius = supportRadius();
+    if (_tilesX < 1 || _tilesY < 1 || radius < 0){
+      return false;
+    }
+
+    std::vector<Tile> tiles(_tilesX*_tilesY);
+    for (int ty = 0; ty < _tilesY; ty++){
+      for (int tx = 0; tx < _tilesX; tx++){
+        Tile &tile = tiles[ty*_tilesX + tx];
+        tile.xMin = tx*sensorWidth_/_tilesX;
+        tile.xMax = (tx+1)*sensorWidth_/_tilesX - 1;
+        tile.yMin = ty*sensorHeight_/_tilesY;
+        tile.yMax = (ty+1)*sensorHeight_/_tilesY - 1;
+
+        tile.detector.reset(newInstance());
+        if (!tile.detector){
+          return false;
+        }
+      }
+    }
+
+    // tile ranges of every column and row, from the same bounds as the tiles so that
+    // dispatching never misses a halo when the tile count does not divide the sensor
+    auto ranges = [&](int _size, int _tiles, bool _columns, std::vector<int> &_min, std::vector<int> &_max){
+      _min.assign(_size, _tiles);
+      _max.assign(_size, -1);
+      for (int t = 0; t < _tiles; t++){
+        const Tile &tile = _columns ? tiles[t] : tiles[t*_tilesX];
+        const int lo = std::max(0, (_columns ? tile.xMin : tile.yMin) - radius);
+        const int hi = std::min(_size-1, (_columns ? tile.xMax : tile.yMax) + radius);
+        for (int i = lo; i <= hi; i++){
+          _min[i] = std::min(_min[i], t);
+          _max[i] = std::max(_max[i], t);
+        }
+      }
+    };
+    ranges(sensorWidth_, _tilesX, true, columnTileMin_, columnTileMax_);
+    ranges(sensorHeight_, _tilesY, false, rowTileMin_, rowTileMax_);
+
+    tiles_ = std::move(tiles);
+    tilesX_ = _tilesX;
+    tilesY_ = _tilesY;
+    return true;
+  }
+
+  void Detector::disableParallelMode(){
+    tiles_.clear();
+  }
+
+  void Detector::parallelDetect(){
+    std::fill(isCorner_.begin(), isCorner_.end(), 0);
+
+    // dispatch every event to the tiles whose core or halo contains it, keeping the order
+    for (auto &tile : tiles_){
+      tile.indices.clear();
+      tile.events.clear();
+    }
+
+    for (std::size_t i = 0; i < batch_.size(); i++){
+      const int x = batch_[i].x();
+      const int y = batch_[i].y();
+
+      if (x < 0 || x >= sensorWidth_ || y < 0 || y >= sensorHeight_){
+        continue;
+      }
+
+      for (int ty = rowTileMin_[y]; ty <= rowTileMax_[y]; ty++){
+        for (int tx = columnTileMin_[x]; tx <= columnTileMax_[x]; tx++){
+          Tile &tile = tiles_[ty*tilesX_ + tx];
+          tile.indices.push_back(i);
+          tile.events.push_back(batch_[i]);
+        }
+      }
+    }
+
+    // every tile writes the flags of the events it owns only
+    ThreadPool::TaskGroup workers;
+    for (auto &tile : tiles_){
+      if (tile.events.empty()){
+        continue;
+      }
+
+      workers.run([this, &tile](){
+        tile.isCorner.resize(tile.events.size());
+        tile.scores.resize(tile.events.size());
+        tile.detector->isFeatureBatch(tile.events.data(), tile.events.size(), tile.isCorner.data(), tile.scores.data());
+
+        // halo events only update state
+        for (std::size_t k = 0; k < tile.events.size(); k++){
+          const dv::Event &e = tile.events[k];
+          if (e.x() >= tile.xMin && e.x() <= tile.xMax && e.y() >= tile.yMin && e.y() <= tile.yMax){
+            isCorner_[tile.indices[k]] = tile.isCorner[k];
+            scores_[tile.indices[k]]   = tile.scores[k];
+          }
+        }
+      });
+    }
+
+    workers.wait();
+  }
+
 } // namespace
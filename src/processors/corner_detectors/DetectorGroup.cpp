@@ -0,0 +1,53 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/processors/corner_detectors/DetectorGroup.h>
+
+namespace dvsal{
+
+  DetectorGroup::DetectorGroup(int _width, int _height) : surface_(_width, _height){
+  }
+
+  std::size_t DetectorGroup::addDetector(Detector *_detector){
+    detectors_.push_back({_detector, dv::EventStore(), std::vector<double>()});
+    return detectors_.size() - 1;
+  }
+
+  void DetectorGroup::eventCallback(const dv::EventStore &_msg){
+    for (auto &entry : detectors_){
+      entry.corners = dv::EventStore();
+      entry.scores.clear();
+    }
+
+    // the surface has to be updated in lockstep with detection: a detector reading it must
+    // see every event up to the current one, and none after it
+    for (const auto &e : _msg){
+      surface_.update(e);
+      for (auto &entry : detectors_){
+        if (entry.detector->isFeature(e)){
+          entry.corners.add(e);
+          entry.scores.push_back(entry.detector->getLastScore());
+        }
+      }
+    }
+  }
+
+} // namespace
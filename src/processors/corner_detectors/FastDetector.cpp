@@ -23,124 +23,34 @@
 
 namespace dvsal{
 
-  FastDetector::FastDetector() :
-    circle3_ {{0, 3}, {1, 3}, {2, 2}, {3, 1},
-              {3, 0}, {3, -1}, {2, -2}, {1, -3},
-              {0, -3}, {-1, -3}, {-2, -2}, {-3, -1},
-              {-3, 0}, {-3, 1}, {-2, 2}, {-1, 3}},
-    circle4_ {{0, 4}, {1, 4}, {2, 3}, {3, 2},
-              {4, 1}, {4, 0}, {4, -1}, {3, -2},
-              {2, -3}, {1, -4}, {0, -4}, {-1, -4},
-              {-2, -3}, {-3, -2}, {-4, -1}, {-4, 0},
-              {-4, 1}, {-3, 2}, {-2, 3}, {-1, 4}}
-  {
+  FastDetector::FastDetector(){
     detectorName_ = "FAST";
 
     // allocate SAE matrices
-    sae_[0] = Eigen::MatrixXd::Zero(sensorWidth_ , sensorHeight_);
-    sae_[1] = Eigen::MatrixXd::Zero(sensorWidth_ , sensorHeight_);
+    ownSae_[0] = Eigen::MatrixXd::Zero(sensorWidth_ , sensorHeight_);
+    ownSae_[1] = Eigen::MatrixXd::Zero(sensorWidth_ , sensorHeight_);
+    sae_ = ownSae_;
   }
 
-  FastDetector::~FastDetector(){
-  }
-
-  bool FastDetector::isFeature(const dv::Event &e){
-    // update SAE
-    const int pol = e.polarity() ? 1 : 0;
-    sae_[pol](e.x(), e.y()) = e.timestamp() * 0.000001;
-
-    const int max_scale = 1;
-
-    // only check if not too close to border
-    const int cs = max_scale*4;
-    if (e.x() < cs || e.x() >= sensorWidth_-cs || e.y() < cs || e.y() >= sensorHeight_-cs){
-      return false;
+  FastDetector::FastDetector(const TimeSurface &_surface) : FastDetector(){
+    // isFeature indexes the SAE with the sensor size of the detector
+    if (_surface.width() != sensorWidth_ || _surface.height() != sensorHeight_){
+      std::cout << "Time surface of " << _surface.width() << "x" << _surface.height() << " does not match the "
+                << sensorWidth_ << "x" << sensorHeight_ << " sensor of FAST, using its own SAE" << std::endl;
+      return;
     }
 
-    bool found_streak = false;
-
-    for (int i=0; i<16; i++){
-      for (int streak_size = 3; streak_size<=6; streak_size++){
-        // check that streak event is larger than neighbor
-        if (sae_[pol](e.x()+circle3_[i][0], e.y()+circle3_[i][1]) <
-                              sae_[pol](e.x()+circle3_[(i-1+16)%16][0], e.y()+circle3_[(i-1+16)%16][1]))
-          continue;
-
-        // check that streak event is larger than neighbor
-        if (sae_[pol](e.x()+circle3_[(i+streak_size-1)%16][0], e.y()+circle3_[(i+streak_size-1)%16][1]) <
-                  sae_[pol](e.x()+circle3_[(i+streak_size)%16][0], e.y()+circle3_[(i+streak_size)%16][1]))
-          continue;
-
-        double min_t = sae_[pol](e.x()+circle3_[i][0], e.y()+circle3_[i][1]);
-        for (int j=1; j<streak_size; j++){
-          const double tj = sae_[pol](e.x()+circle3_[(i+j)%16][0], e.y()+circle3_[(i+j)%16][1]);
-          if (tj < min_t)
-            min_t = tj;
-        }
-
-        bool did_break = false;
-        for (int j=streak_size; j<16; j++){
-          const double tj = sae_[pol](e.x()+circle3_[(i+j)%16][0], e.y()+circle3_[(i+j)%16][1]);
-
-          if (tj >= min_t){
-            did_break = true;
-            break;
-          }
-        }
-
-        if (!did_break){
-          found_streak = true;
-          break;
-        }
-
-      }
-      if (found_streak){
-        break;
-      }
-    }
-
-    if (found_streak){
-      found_streak = false;
-      for (int i=0; i<20; i++){
-        for (int streak_size = 4; streak_size<=8; streak_size++){
-          // check that first event is larger than neighbor
-          if (sae_[pol](e.x()+circle4_[i][0], e.y()+circle4_[i][1]) <  
-                          sae_[pol](e.x()+circle4_[(i-1+20)%20][0], e.y()+circle4_[(i-1+20)%20][1]))
-            continue;
-
-          // check that streak event is larger than neighbor
-          if (sae_[pol](e.x()+circle4_[(i+streak_size-1)%20][0], e.y()+circle4_[(i+streak_size-1)%20][1]) <          
-                          sae_[pol](e.x()+circle4_[(i+streak_size)%20][0], e.y()+circle4_[(i+streak_size)%20][1]))
-            continue;
-
-          double min_t = sae_[pol](e.x()+circle4_[i][0], e.y()+circle4_[i][1]);
-          for (int j=1; j<streak_size; j++){
-            const double tj = sae_[pol](e.x()+circle4_[(i+j)%20][0], e.y()+circle4_[(i+j)%20][1]);
-            if (tj < min_t)
-              min_t = tj;
-          }
-
-          bool did_break = false;
-          for (int j=streak_size; j<20; j++){
-            const double tj = sae_[pol](e.x()+circle4_[(i+j)%20][0], e.y()+circle4_[(i+j)%20][1]);
-            if (tj >= min_t){
-              did_break = true;
-              break;
-            }
-          }
+    ownSae_[0].resize(0, 0);
+    ownSae_[1].resize(0, 0);
+    sae_ = _surface.sae();
+    surface_ = &_surface;
+  }
 
-          if (!did_break){
-            found_streak = true;
-            break;
-          }
-        }
-        if (found_streak){
-          break;
-        }
-      }
-    }
+  FastDetector::~FastDetector(){
+  }
 
-    return found_streak;
+  std::size_t FastDetector::isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores){
+    return batchLoop(*this, _events, _size, _isCorner, _scores);
   }
 
 } // namespace
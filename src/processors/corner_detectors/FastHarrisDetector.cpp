@@ -0,0 +1,67 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include "dvsal/processors/corner_detectors/FastHarrisDetector.h"
+
+namespace dvsal{
+
+  FastHarrisDetector::FastHarrisDetector(){
+    detectorName_ = "FAST-HARRIS";
+  }
+
+  FastHarrisDetector::FastHarrisDetector(const TimeSurface &_surface) : fast_(_surface){
+    detectorName_ = "FAST-HARRIS";
+  }
+
+  FastHarrisDetector::~FastHarrisDetector(){
+  }
+
+  std::size_t FastHarrisDetector::isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores){
+    // FAST does not read the Harris queues, so the candidates are found first. The queues are
+    // then brought up to every candidate with one batch update and the candidate is scored,
+    // which gives the same result as the per event path.
+    for (std::size_t i = 0; i < _size; i++){
+      _isCorner[i] = fast_.FastDetector::isFeature(_events[i]);
+    }
+
+    std::size_t corners = 0;
+    std::size_t updated = 0;
+    for (std::size_t i = 0; i < _size; i++){
+      if (!_isCorner[i])
+        continue;
+
+      harris_.updateQueues(_events + updated, i + 1 - updated);
+      updated = i + 1;
+      if (harris_.isCorner(_events[i])){
+        lastScore_ = harris_.getLastScore();
+        if (_scores != nullptr)
+          _scores[i] = lastScore_;
+        corners++;
+      }
+      else{
+        _isCorner[i] = 0;
+      }
+    }
+    harris_.updateQueues(_events + updated, _size - updated);
+    return corners;
+  }
+
+} // namespace
@@ -23,7 +23,7 @@
 
 namespace dvsal{
 
-  HarrisDetector::HarrisDetector(){
+  HarrisDetector::HarrisDetector(bool _lazyQueues) : lazyQueues_(_lazyQueues){
     detectorName_ = "Harris";
 
     // parameters
@@ -32,7 +32,7 @@ namespace dvsal{
     kernelSize_ = 5;
     harrisThreshold_ = 8.0;
 
-    queues_ = new DistinctQueue(windowSize_, queueSize_, true);
+    queues_ = new DistinctQueue(windowSize_, queueSize_, true, sensorWidth_, sensorHeight_, lazyQueues_);
 
     Eigen::VectorXd Dx = Eigen::VectorXd(kernelSize_);
     Eigen::VectorXd Sx = Eigen::VectorXd(kernelSize_);
@@ -59,23 +59,11 @@ namespace dvsal{
   }
 
   HarrisDetector::~HarrisDetector(){
+    delete queues_;
   }
 
-  bool HarrisDetector::isFeature(const dv::Event &e){
-    // update queues
-    queues_->newEvent(e.x(), e.y(), e.polarity());
-
-    // check if queue is full
-    double score = harrisThreshold_ - 10.;
-    if (queues_->isFull(e.x(), e.y(), e.polarity()))
-    {
-      // check if current event is a feature
-      score = getHarrisScore(e.x(), e.y(), e.polarity());
-
-      lastScore_ = score;
-    }
-
-    return (score > harrisThreshold_);
+  std::size_t HarrisDetector::isFeatureBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isCorner, double *_scores){
+    return batchLoop(*this, _events, _size, _isCorner, _scores);
   }
 
   double HarrisDetector::getHarrisScore(int img_x, int img_y, bool polarity){
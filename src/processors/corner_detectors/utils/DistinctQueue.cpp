@@ -21,55 +21,272 @@
 
 #include <dvsal/processors/corner_detectors/utils/DistinctQueue.h>
 
+#include <cassert>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <new>
+
 namespace dvsal{
 
-  DistinctQueue::DistinctQueue(int window_size, int queue_size, bool use_polarity) :
-    LocalEventQueues(window_size, queue_size)
+  namespace{
+    std::size_t alignUp(std::size_t _size, std::size_t _alignment){
+      return (_size + _alignment - 1) / _alignment * _alignment;
+    }
+  }
+
+  DistinctQueue::DistinctQueue(int window_size, int queue_size, bool use_polarity,
+                               int sensor_width, int sensor_height, bool lazy_allocation) :
+    LocalEventQueues(window_size, queue_size),
+    lazyAllocation_(lazy_allocation),
+    usePolarity_(use_polarity),
+    sensorWidth_(sensor_width),
+    sensorHeight_(sensor_height),
+    sequence_(0)
   {
-    // create queues
+    windowDim_ = 2*window_size+1;
+
+    // neighbourhood counters are 16 bit
+    assert(windowDim_*windowDim_ <= std::numeric_limits<uint16_t>::max());
+
+    patchStamps_.resize(windowDim_*windowDim_);
+    selection_.reserve(windowDim_*windowDim_);
+
+    // page layout, every section keeps the page alignment
+    touchedOffset_ = alignUp(sizeof(uint64_t)*tilePixels_, pageAlignment_);
+    pageBytes_     = touchedOffset_ + alignUp(sizeof(uint16_t)*tilePixels_, pageAlignment_);
+
+    // create page table
     const int polarities = use_polarity ? 2 : 1;
-    const int num_queues = sensorWidth_*sensorHeight_ * polarities;
+    tilesX_ = (sensorWidth_ + tileSize_ - 1) >> tileShift_;
+    tilesY_ = (sensorHeight_ + tileSize_ - 1) >> tileShift_;
+    pages_.assign(tilesX_*tilesY_*polarities, nullptr);
+
+    if (lazyAllocation_){
+      return;
+    }
+
+    // all pages in a single allocation
+    void *arena = std::aligned_alloc(pageAlignment_, pageBytes_*pages_.size());
+    if (arena == nullptr){
+      throw std::bad_alloc();
+    }
+    blocks_.push_back(arena);
 
-    queues_ = std::vector<FixedDistinctQueue>
-              (num_queues, FixedDistinctQueue(2*window_size+1, queue_size));
+    for (std::size_t i = 0; i < pages_.size(); i++){
+      pages_[i] = static_cast<uint8_t*>(arena) + i*pageBytes_;
+      initPage(pages_[i]);
+    }
   }
 
   DistinctQueue::~DistinctQueue(){
+    for (void *block : blocks_){
+      std::free(block);
+    }
+  }
+
+  std::size_t DistinctQueue::allocatedBytes() const{
+    if (!lazyAllocation_){
+      return pageBytes_*pages_.size();
+    }
+    return pageBytes_*blocks_.size();
   }
 
   bool DistinctQueue::isFull(int x, int y, bool pol) const{
-    return queues_[getIndex(x, y, pol)].isFull();
+    uint8_t *page = pages_[getTile(x, y, pol)];
+    if (page == nullptr){
+      return false;
+    }
+    return pageTouched(page)[getLocalIndex(x, y)] >= queue_size_;
   }
 
   void DistinctQueue::newEvent(int x, int y, bool pol)
   {
-    // update neighboring pixels
-    for (int dx=-window_size_; dx<=window_size_; dx++)
+    uint8_t *page = getPage(getTile(x, y, pol));
+    uint64_t &stamp = pageStamps(page)[getLocalIndex(x, y)];
+
+    // a new distinct pixel for all the queues around it
+    if (stamp == 0)
+    {
+      touchNeighbourhood(x, y, pol);
+    }
+
+    stamp = ++sequence_;
+  }
+
+  void DistinctQueue::newEvents(const dv::Event *events, std::size_t size)
+  {
+    // events are spatially clustered, keep the page of the previous one at hand
+    int last_tile = -1;
+    uint8_t *page = nullptr;
+
+    for (std::size_t i = 0; i < size; i++)
     {
-      for (int dy=-window_size_; dy<=window_size_; dy++)
+      const int x = events[i].x();
+      const int y = events[i].y();
+      const bool pol = events[i].polarity();
+
+      const int tile = getTile(x, y, pol);
+      if (tile != last_tile)
+      {
+        page = getPage(tile);
+        last_tile = tile;
+      }
+
+      uint64_t &stamp = pageStamps(page)[getLocalIndex(x, y)];
+      if (stamp == 0)
       {
-        // in limits?
-        if (x+dx<0 or x+dx>=sensorWidth_ or y+dy<0 or y+dy>=sensorHeight_)
+        touchNeighbourhood(x, y, pol);
+      }
+
+      stamp = ++sequence_;
+    }
+  }
+
+  void DistinctQueue::touchNeighbourhood(int x, int y, bool pol)
+  {
+    // clip the neighbourhood once instead of testing every pixel
+    const int x_min = std::max(x-window_size_, 0);
+    const int x_max = std::min(x+window_size_, sensorWidth_-1);
+    const int y_min = std::max(y-window_size_, 0);
+    const int y_max = std::min(y+window_size_, sensorHeight_-1);
+
+    // update neighboring pixels tile by tile, contiguous rows inside each page
+    for (int ty = y_min >> tileShift_; ty <= (y_max >> tileShift_); ty++)
+    {
+      const int py_min = std::max(y_min, ty << tileShift_);
+      const int py_max = std::min(y_max, ((ty+1) << tileShift_) - 1);
+
+      for (int tx = x_min >> tileShift_; tx <= (x_max >> tileShift_); tx++)
+      {
+        const int px_min = std::max(x_min, tx << tileShift_);
+        const int px_max = std::min(x_max, ((tx+1) << tileShift_) - 1);
+        const int width  = px_max - px_min + 1;
+
+        uint16_t *touched = pageTouched(getPage(getTile(px_min, py_min, pol)));
+
+        for (int py = py_min; py <= py_max; py++)
         {
-          continue;
+          uint16_t *row = touched + getLocalIndex(px_min, py);
+          for (int i = 0; i < width; i++)
+          {
+            row[i]++;
+          }
         }
-
-        // update pixel's queue
-        queues_[getIndex(x+dx, y+dy, pol)].addNew(window_size_+dx,
-                                                  window_size_+dy);
       }
     }
   }
 
   Eigen::MatrixXi DistinctQueue::getPatch(int x, int y, bool pol)
   {
-    return queues_[getIndex(x, y, pol)].getWindow();
+    // window cell (i, j) of pixel (x, y) is fed by the events at (x+w-i, y+w-j)
+    const int w = window_size_;
+    const bool inside_tile = x-w >= 0 && x+w < sensorWidth_ && y-w >= 0 && y+w < sensorHeight_ &&
+                             ((x-w) >> tileShift_) == ((x+w) >> tileShift_) &&
+                             ((y-w) >> tileShift_) == ((y+w) >> tileShift_);
+    uint8_t *page = pages_[getTile(x, y, pol)];
+
+    if (inside_tile && page != nullptr)
+    {
+      const uint64_t *stamps = pageStamps(page);
+      for (int i = 0; i < windowDim_; i++)
+      {
+        for (int j = 0; j < windowDim_; j++)
+        {
+          patchStamps_[i*windowDim_ + j] = stamps[getLocalIndex(x+w-i, y+w-j)];
+        }
+      }
+    }
+    else
+    {
+      for (int i = 0; i < windowDim_; i++)
+      {
+        for (int j = 0; j < windowDim_; j++)
+        {
+          patchStamps_[i*windowDim_ + j] = getStamp(x+w-i, y+w-j, pol);
+        }
+      }
+    }
+
+    // the queue holds the queue_size newest pixels of the window
+    selection_.clear();
+    for (const uint64_t stamp : patchStamps_)
+    {
+      if (stamp != 0)
+      {
+        selection_.push_back(stamp);
+      }
+    }
+
+    uint64_t threshold = 1;
+    if (selection_.size() > static_cast<std::size_t>(queue_size_))
+    {
+      std::nth_element(selection_.begin(), selection_.begin() + (queue_size_-1), selection_.end(),
+                       std::greater<uint64_t>());
+      threshold = selection_[queue_size_-1];
+    }
+
+    Eigen::MatrixXi patch(windowDim_, windowDim_);
+    for (int i = 0; i < windowDim_; i++)
+    {
+      for (int j = 0; j < windowDim_; j++)
+      {
+        patch(i, j) = (patchStamps_[i*windowDim_ + j] >= threshold) ? 1 : 0;
+      }
+    }
+    return patch;
+  }
+
+  uint64_t DistinctQueue::getStamp(int x, int y, bool pol) const
+  {
+    if (x < 0 || x >= sensorWidth_ || y < 0 || y >= sensorHeight_)
+    {
+      return 0;
+    }
+
+    uint8_t *page = pages_[getTile(x, y, pol)];
+    if (page == nullptr)
+    {
+      return 0;
+    }
+    return pageStamps(page)[getLocalIndex(x, y)];
+  }
+
+  int DistinctQueue::getTile(int x, int y, bool polarity) const
+  {
+    const int polarity_offset = (usePolarity_ && polarity) ? tilesX_*tilesY_ : 0;
+    return (y >> tileShift_)*tilesX_ + (x >> tileShift_) + polarity_offset;
+  }
+
+  int DistinctQueue::getLocalIndex(int x, int y) const
+  {
+    return ((y & tileMask_) << tileShift_) + (x & tileMask_);
+  }
+
+  uint8_t *DistinctQueue::getPage(int tile)
+  {
+    uint8_t *&page = pages_[tile];
+    if (page == nullptr)
+    {
+      // first event landing on this tile
+      void *block = std::aligned_alloc(pageAlignment_, pageBytes_);
+      if (block == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+      blocks_.push_back(block);
+
+      page = static_cast<uint8_t*>(block);
+      initPage(page);
+    }
+    return page;
   }
 
-  int DistinctQueue::getIndex(int x, int y, bool polarity) const
+  void DistinctQueue::initPage(uint8_t *page) const
   {
-    int polarity_offset = polarity ? sensorHeight_*sensorWidth_ : 0;
-    return y*sensorWidth_ + x + polarity_offset;
+    std::fill_n(pageStamps(page), tilePixels_, uint64_t(0));
+    std::fill_n(pageTouched(page), tilePixels_, uint16_t(0));
   }
 
 } // namespace
@@ -0,0 +1,71 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/processors/corner_detectors/utils/NonMaxSuppression.h>
+
+#include <algorithm>
+
+namespace dvsal{
+
+  NonMaxSuppression::NonMaxSuppression(int _radius, int64_t _timeWindow, int _sensorWidth, int _sensorHeight) :
+    radius_(std::max(_radius, 1)),
+    timeWindow_(_timeWindow)
+  {
+    bucketsX_ = (_sensorWidth + radius_ - 1) / radius_;
+    bucketsY_ = (_sensorHeight + radius_ - 1) / radius_;
+    reset();
+  }
+
+  void NonMaxSuppression::reset(){
+    buckets_.assign(bucketsX_*bucketsY_, std::vector<Entry>());
+  }
+
+  bool NonMaxSuppression::isMaximum(const dv::Event &_corner, double _score){
+    const int bx = _corner.x() / radius_;
+    const int by = _corner.y() / radius_;
+
+    // any stronger recent corner close enough?
+    for (int ny = std::max(by-1, 0); ny <= std::min(by+1, bucketsY_-1); ny++){
+      for (int nx = std::max(bx-1, 0); nx <= std::min(bx+1, bucketsX_-1); nx++){
+        std::vector<Entry> &bucket = buckets_[ny*bucketsX_ + nx];
+
+        // entries are in time order, the expired ones are a prefix
+        auto live = std::find_if(bucket.begin(), bucket.end(), [&](const Entry &_entry){
+          return _corner.timestamp() - _entry.timestamp <= timeWindow_;
+        });
+        bucket.erase(bucket.begin(), live);
+
+        for (const Entry &entry : bucket){
+          const int dx = entry.x - _corner.x();
+          const int dy = entry.y - _corner.y();
+          if (dx*dx + dy*dy <= radius_*radius_ && entry.score >= _score){
+            return false;
+          }
+        }
+      }
+    }
+
+    // a weaker kept corner must not evict a stronger one of the same bucket, all are kept
+    buckets_[by*bucketsX_ + bx].push_back(Entry{_corner.timestamp(), _score, _corner.x(), _corner.y()});
+    return true;
+  }
+
+} // namespace
@@ -0,0 +1,53 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/processors/filters/EventFilter.h>
+
+namespace dvsal{
+
+  std::size_t EventFilter::isValidBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isValid){
+    std::size_t valid = 0;
+    for (std::size_t i = 0; i < _size; i++){
+      _isValid[i] = isValid(_events[i]);
+      valid += _isValid[i];
+    }
+    return valid;
+  }
+
+  std::size_t EventFilter::isValidBatch(const EventBatch &_batch, uint8_t *_isValid){
+    std::size_t valid = 0;
+    for (std::size_t i = 0; i < _batch.size(); i++){
+      _isValid[i] = isValid(_batch.event(i));
+      valid += _isValid[i];
+    }
+    return valid;
+  }
+
+  void EventFilter::eventCallback(const dv::EventStore &_msg){
+    dv::EventStore filtered;
+    for (const auto &e : _msg){
+      if (isValid(e))
+        filtered.add(e);
+    }
+    filteredEvents_ = filtered;
+  }
+
+} // namespace
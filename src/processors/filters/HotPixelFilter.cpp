@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/processors/filters/HotPixelFilter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace dvsal{
+
+  HotPixelFilter::HotPixelFilter(double _maxRate, int64_t _learningWindow, int64_t _refractoryPeriod,
+                                 int _width, int _height) :
+      width_(_width), height_(_height),
+      // counts are integers, count > limit is count >= floor(limit) + 1
+      hotCount_(static_cast<uint32_t>(std::min(std::floor(std::max(0.0, _maxRate * _learningWindow * 0.000001)) + 1.0,
+                                               double(std::numeric_limits<uint32_t>::max())))),
+      learningWindow_(_learningWindow),
+      refractoryPeriod_(static_cast<uint32_t>(_refractoryPeriod)){
+    const std::size_t pixels = std::size_t(width_)*height_;
+    mask_.assign((pixels + 63)/64, 0);
+    counts_.assign(pixels, 0);
+    lastAccepted_.assign(pixels, 0);
+    seen_.assign(pixels, 0);
+  }
+
+  std::size_t HotPixelFilter::isValidBatch(const dv::Event *_events, std::size_t _size, uint8_t *_isValid){
+    return batchLoop(*this, _events, _size, _isValid);
+  }
+
+  std::size_t HotPixelFilter::isValidBatch(const EventBatch &_batch, uint8_t *_isValid){
+    const int64_t *timestamps = _batch.timestamps();
+    const int16_t *xs = _batch.xs();
+    const int16_t *ys = _batch.ys();
+    std::size_t valid = 0;
+    for (std::size_t i = 0; i < _batch.size(); i++){
+      _isValid[i] = check(timestamps[i], xs[i], ys[i]);
+      valid += _isValid[i];
+    }
+    return valid;
+  }
+
+  void HotPixelFilter::setLearning(bool _learning){
+    learning_ = _learning;
+    std::fill(counts_.begin(), counts_.end(), 0);
+    windowStart_ = -1;
+  }
+
+  void HotPixelFilter::setHot(int _x, int _y){
+    const std::size_t idx = std::size_t(_y)*width_ + _x;
+    mask_[idx >> 6] |= uint64_t(1) << (idx & 63);
+  }
+
+  std::size_t HotPixelFilter::hotPixels() const{
+    std::size_t hot = 0;
+    for (const auto word : mask_){
+      hot += __builtin_popcountll(word);
+    }
+    return hot;
+  }
+
+  void HotPixelFilter::clearHotPixels(){
+    std::fill(mask_.begin(), mask_.end(), 0);
+  }
+
+  void HotPixelFilter::closeWindow(){
+    for (std::size_t idx = 0; idx < counts_.size(); idx++){
+      if (counts_[idx] >= hotCount_)
+        mask_[idx >> 6] |= uint64_t(1) << (idx & 63);
+      counts_[idx] = 0;
+    }
+  }
+
+  bool HotPixelFilter::saveMask(const std::string &_path) const{
+    std::ofstream file(_path);
+    if (!file.is_open()){
+      std::cout << "Could not open hot pixel mask file " << _path << std::endl;
+      return false;
+    }
+
+    for (int y = 0; y < height_; y++){
+      for (int x = 0; x < width_; x++){
+        if (isHot(x, y))
+          file << x << " " << y << "\n";
+      }
+    }
+    return bool(file);
+  }
+
+  bool HotPixelFilter::loadMask(const std::string &_path){
+    std::ifstream file(_path);
+    if (!file.is_open()){
+      std::cout << "Could not open hot pixel mask file " << _path << std::endl;
+      return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)){
+      std::istringstream iss(line);
+      int x, y;
+      if (!(iss >> x >> y)){
+        continue;
+      }
+      if (x < 0 || x >= width_ || y < 0 || y >= height_){
+        std::cout << "Hot pixel " << x << " " << y << " out of the sensor, ignored" << std::endl;
+        continue;
+      }
+      setHot(x, y);
+    }
+    return true;
+  }
+
+} // namespace
@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/processors/surfaces/ExponentialTimeSurface.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace dvsal{
+
+  ExponentialTimeSurface::ExponentialTimeSurface(const std::vector<double> &_taus, int _width, int _height) :
+      ownSurface_(new TimeSurface(_width, _height)), surface_(ownSurface_.get()){
+    for (const auto tau : _taus){
+      taus_.push_back(tau * 0.000001);
+    }
+    setMinValue(minValue_);
+  }
+
+  ExponentialTimeSurface::ExponentialTimeSurface(const TimeSurface &_surface, const std::vector<double> &_taus) :
+      surface_(&_surface){
+    for (const auto tau : _taus){
+      taus_.push_back(tau * 0.000001);
+    }
+    setMinValue(minValue_);
+  }
+
+  void ExponentialTimeSurface::eventCallback(const dv::EventStore &_msg){
+    if (ownSurface_){
+      ownSurface_->update(_msg);
+    }
+  }
+
+  void ExponentialTimeSurface::setMinValue(double _minValue){
+    minValue_ = _minValue;
+    cutoffs_.clear();
+    for (const auto tau : taus_){
+      cutoffs_.push_back(-tau * std::log(minValue_));
+    }
+  }
+
+  double ExponentialTimeSurface::value(int _x, int _y, bool _polarity, int64_t _time, std::size_t _tauIdx) const{
+    const double sae = surface_->timestamp(_x, _y, _polarity);
+    const double age = std::max(_time * 0.000001 - sae, 0.0);
+    if (sae <= 0.0 || age > cutoffs_[_tauIdx]){
+      return 0.0;
+    }
+    return std::exp(-age / taus_[_tauIdx]);
+  }
+
+  void ExponentialTimeSurface::extract(int64_t _time, std::size_t _tauIdx, bool _polarity, cv::Mat &_frame) const{
+    const int width  = surface_->width();
+    const int height = surface_->height();
+    const int tileSize = TimeSurface::TileSize;
+    _frame.create(height, width, CV_32F);
+
+    const double t = _time * 0.000001;
+    const float invTau = 1.0 / taus_[_tauIdx];
+    const double cutoff = cutoffs_[_tauIdx];
+    const Eigen::MatrixXd &sae = surface_->sae(_polarity);
+
+    for (int ty = 0; ty < surface_->tilesY(); ty++){
+      const int yEnd = std::min(height, (ty+1)*tileSize);
+      for (int tx = 0; tx < surface_->tilesX(); tx++){
+        const int xBegin = tx*tileSize;
+        const int xEnd = std::min(width, xBegin + tileSize);
+
+        // cold tile, every pixel is older than the cutoff
+        const double latest = surface_->tileLatest(tx, ty, _polarity);
+        const bool cold = latest <= 0.0 || t - latest > cutoff;
+
+        for (int y = ty*tileSize; y < yEnd; y++){
+          float *out = _frame.ptr<float>(y);
+          if (cold){
+            std::fill(out + xBegin, out + xEnd, 0.0f);
+            continue;
+          }
+
+          // the SAE is column major and indexed (x, y), so a frame row is contiguous
+          const double *in = sae.data() + std::size_t(y)*width;
+          for (int x = xBegin; x < xEnd; x++){
+            const float age = std::max(float(t - in[x]), 0.0f);
+            out[x] = (in[x] > 0.0 && age <= cutoff) ? std::exp(-age * invTau) : 0.0f;
+          }
+        }
+      }
+    }
+  }
+
+} // namespace
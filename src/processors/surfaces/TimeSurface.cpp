@@ -0,0 +1,66 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/processors/surfaces/TimeSurface.h>
+
+namespace dvsal{
+
+  TimeSurface::TimeSurface(int _width, int _height) :
+      width_(_width), height_(_height),
+      tilesX_((_width + TileSize - 1)/TileSize), tilesY_((_height + TileSize - 1)/TileSize){
+    reset();
+  }
+
+  void TimeSurface::update(const dv::EventStore &_events){
+    for (const auto &e : _events){
+      update(e);
+    }
+  }
+
+  void TimeSurface::update(const EventBatch &_batch){
+    // the conversion to seconds runs on the timestamp column alone, then the scatter
+    const std::size_t n = _batch.size();
+    const int64_t *timestamps = _batch.timestamps();
+    seconds_.resize(n);
+    for (std::size_t i = 0; i < n; i++){
+      seconds_[i] = timestamps[i] * 0.000001;
+    }
+
+    const int16_t *xs = _batch.xs();
+    const int16_t *ys = _batch.ys();
+    for (std::size_t i = 0; i < n; i++){
+      const int pol = _batch.polarity(i) ? 1 : 0;
+      sae_[pol](xs[i], ys[i]) = seconds_[i];
+
+      double &latest = tileLatest_[pol][(ys[i]/TileSize)*tilesX_ + xs[i]/TileSize];
+      if (seconds_[i] > latest)
+        latest = seconds_[i];
+    }
+  }
+
+  void TimeSurface::reset(){
+    for (int pol = 0; pol < 2; pol++){
+      sae_[pol] = Eigen::MatrixXd::Zero(width_, height_);
+      tileLatest_[pol].assign(tilesX_*tilesY_, 0.0);
+    }
+  }
+
+} // namespace
@@ -21,6 +21,8 @@
 
 #include <dvsal/streamers/CameraDVS128Streamer.h>
 
+#include <algorithm>
+
 namespace dvsal{
 
     bool CameraDVS128Streamer::init(){
@@ -59,46 +61,57 @@ namespace dvsal{
         return false;
     }
 
-    bool CameraDVS128Streamer::step(){
-        if (!globalShutdown_.load(std::memory_order_relaxed)) {
-		    std::unique_ptr<libcaer::events::EventPacketContainer> packetContainer = dvs128Handle_->dataGet();
-		    if (packetContainer == nullptr) {
-		    	// continue; // Skip if nothing there.
-		    }
-            printf("\nGot event container with %d packets (allocated).\n", packetContainer->size());
+    bool CameraDVS128Streamer::acquire(dv::EventStore &_events){
+        if (globalShutdown_.load(std::memory_order_relaxed)) {
+            return false;
+        }
 
-		    for (auto &packet : *packetContainer) {
-			    if (packet == nullptr) {
-				    printf("Packet is empty (not present).\n");
-				    continue; // Skip if nothing there.
-			    }
+        std::unique_ptr<libcaer::events::EventPacketContainer> packetContainer = dvs128Handle_->dataGet();
+        if (packetContainer == nullptr) {
+            return true; // Skip if nothing there.
+        }
+
+        for (auto &packet : *packetContainer) {
+            if (packet == nullptr || packet->getEventType() != POLARITY_EVENT) {
+                continue; // Skip if nothing there.
+            }
 
-			    printf("Packet of type %d -> %d events, %d capacity.\n", packet->getEventType(), packet->getEventNumber(),
-				    packet->getEventCapacity());
+            std::shared_ptr<const libcaer::events::PolarityEventPacket> polarity
+                = std::static_pointer_cast<libcaer::events::PolarityEventPacket>(packet);
 
-			    if (packet->getEventType() == POLARITY_EVENT) {
-				    std::shared_ptr<const libcaer::events::PolarityEventPacket> polarity
-				    	= std::static_pointer_cast<libcaer::events::PolarityEventPacket>(packet);
+            for (const auto &evt : *polarity) {
+                if (!evt.isValid()) {
+                    continue;
+                }
 
-				    // Get full timestamp and addresses of first event.
-				    const libcaer::events::PolarityEvent &firstEvent = (*polarity)[0];
+                dv::Event event(evt.getTimestamp64(*polarity) , static_cast<int16_t>(evt.getX()) , static_cast<int16_t>(evt.getY()) , static_cast<uint8_t>(evt.getPolarity()));
+                _events.add(event);
+            }
+        }
+        return true;
+    }
 
-			    	int32_t ts = firstEvent.getTimestamp();
-			    	uint16_t x = firstEvent.getX();
-			    	uint16_t y = firstEvent.getY();
-			    	bool pol   = firstEvent.getPolarity();
+    bool CameraDVS128Streamer::step(){
+        return acquire(lastEvents_);
+    }
 
-			    	printf("First polarity event - ts: %d, x: %d, y: %d, pol: %d.\n", ts, x, y, pol);
+    bool CameraDVS128Streamer::nextPacket(dv::EventStore &_packet, std::size_t _maxEvents){
+        if (_maxEvents == 0){
+            _packet = dv::EventStore();
+            return false;
+        }
 
-                    dv::Event event(static_cast<int64_t>(ts) , static_cast<int16_t>(x) , static_cast<int16_t>(y) , static_cast<uint8_t>(pol));
-        
-                    lastEvents_.add(event);
-			    }
-		    }
+        bool more = true;
+        while (more && pending_.size() < _maxEvents){
+            more = acquire(pending_);
         }
 
+        const std::size_t size = std::min(pending_.size(), _maxEvents);
+        _packet = pending_.slice(0, size);
+        pending_ = pending_.slice(size);
+        lastEvents_ = _packet;
 
-        return false;
+        return more || !pending_.isEmpty();
     }
 
     void CameraDVS128Streamer::events(dv::EventStore &_events , int _microseconds){
@@ -19,14 +19,86 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //---------------------------------------------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <dvsal/streamers/DatasetStreamer.h>
+#include <dvsal/utils/ThreadPool.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace dvsal{
+
+    namespace{
+        const char *skipSpaces(const char *_p, const char *_end){
+            while (_p != _end && (*_p == ' ' || *_p == '\t' || *_p == '\r'))
+                _p++;
+            return _p;
+        }
+
+        bool parseInt(const char *&_p, const char *_end, int &_value){
+            _p = skipSpaces(_p, _end);
+            bool negative = false;
+            if (_p != _end && *_p == '-'){
+                negative = true;
+                _p++;
+            }
+            if (_p == _end || *_p < '0' || *_p > '9')
+                return false;
+
+            int value = 0;
+            while (_p != _end && *_p >= '0' && *_p <= '9')
+                value = value*10 + (*_p++ - '0');
+            _value = negative ? -value : value;
+            return true;
+        }
+
+        // "<seconds> <x> <y> <polarity>". Seconds are converted to microseconds from their
+        // digits, exactly, rounding beyond the sixth decimal.
+        bool parseEvent(const char *_p, const char *_end, dv::Event &_event){
+            _p = skipSpaces(_p, _end);
+            if (_p == _end || *_p < '0' || *_p > '9')
+                return false;
+
+            int64_t seconds = 0;
+            while (_p != _end && *_p >= '0' && *_p <= '9')
+                seconds = seconds*10 + (*_p++ - '0');
+
+            int64_t micro = 0;
+            int decimals = 0;
+            if (_p != _end && *_p == '.'){
+                _p++;
+                while (_p != _end && *_p >= '0' && *_p <= '9'){
+                    if (decimals < 6)
+                        micro = micro*10 + (*_p - '0');
+                    else if (decimals == 6 && *_p >= '5')
+                        micro++;
+                    decimals++;
+                    _p++;
+                }
+            }
+            for (; decimals < 6; decimals++)
+                micro *= 10;
+
+            int x, y, pol;
+            if (!parseInt(_p, _end, x) || !parseInt(_p, _end, y) || !parseInt(_p, _end, pol))
+                return false;
+
+            _event = dv::Event(seconds*1000000 + micro, static_cast<int16_t>(x), static_cast<int16_t>(y), static_cast<uint8_t>(pol));
+            return true;
+        }
+    }
     
     DatasetStreamer::DatasetStreamer(const std::string _string){
         datasetPath_ = _string;    
     };
+
+    DatasetStreamer::~DatasetStreamer(){
+        stopStreaming();
+    }
     
     bool DatasetStreamer::init(){
         if(!std::filesystem::exists(datasetPath_)){
@@ -34,26 +106,123 @@ namespace dvsal{
             return false;
         }
 
-        datasetFile_ = std::ifstream(datasetPath_);
+        datasetFile_ = std::ifstream(datasetPath_, std::ios::binary);
+        buffer_.resize(1 << 20);
+        bufferBegin_ = bufferEnd_ = 0;
+        bufferOffset_ = 0;
+        endOfFile_ = false;
+
+        indexComplete_ = loadIndex();
+        if (!indexComplete_){
+            index_.clear();
+            indexing_ = true;
+            eventsSinceEntry_ = 0;
+        }
         return true;
     }
 
+    bool DatasetStreamer::nextLine(const char *&_begin, const char *&_end){
+        for (;;){
+            const char *begin = buffer_.data() + bufferBegin_;
+            const char *end   = buffer_.data() + bufferEnd_;
+            const char *lineBreak = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+            if (lineBreak != nullptr){
+                _begin = begin;
+                _end = lineBreak;
+                bufferBegin_ = lineBreak + 1 - buffer_.data();
+                return true;
+            }
 
-    bool DatasetStreamer::step(){
-        
-        std::string line;
-        std::getline(datasetFile_, line);  
+            if (endOfFile_){
+                // last line without a line break
+                if (begin == end)
+                    return false;
+                _begin = begin;
+                _end = end;
+                bufferBegin_ = bufferEnd_;
+                return true;
+            }
+
+            // keep the partial line and refill the buffer behind it
+            const std::size_t remaining = end - begin;
+            bufferOffset_ += bufferBegin_;
+            std::memmove(buffer_.data(), begin, remaining);
+            bufferBegin_ = 0;
+            bufferEnd_ = remaining;
+            if (bufferEnd_ == buffer_.size())
+                buffer_.resize(buffer_.size()*2);
+
+            datasetFile_.read(buffer_.data() + bufferEnd_, buffer_.size() - bufferEnd_);
+            bufferEnd_ += datasetFile_.gcount();
+            if (!datasetFile_)
+                endOfFile_ = true;
+        }
+    }
+
+    bool DatasetStreamer::readEvent(dv::Event &_event, bool &_valid){
+        const char *begin, *end;
+        if (!nextLine(begin, end)){
+            if (indexing_){
+                // first complete pass
+                indexing_ = false;
+                indexComplete_ = true;
+                saveIndex();
+            }
+            return false;
+        }
+
+        _valid = parseEvent(begin, end, _event);
+        if (_valid && indexing_){
+            if (index_.empty() || ++eventsSinceEntry_ >= IndexEvents || _event.timestamp() - index_.back().timestamp >= IndexInterval){
+                index_.push_back({_event.timestamp(), bufferOffset_ + (begin - buffer_.data())});
+                eventsSinceEntry_ = 0;
+            }
+        }
+        return true;
+    }
+
+    bool DatasetStreamer::nextPacket(dv::EventStore &_packet, std::size_t _maxEvents){
+        if (_maxEvents == 0){
+            _packet = dv::EventStore();
+            return false;
+        }
 
-        std::istringstream iss(line);
-        float timestamp;
-        int x, y, pol;
+        dv::EventStore packet;
+        std::size_t size = 0;
+        bool more = true;
+        while (size < _maxEvents){
+            // skip malformed lines
+            dv::Event event;
+            bool valid;
+            if (!readEvent(event, valid)){
+                more = false;
+                break;
+            }
+            if (valid){
+                packet.add(event);
+                size++;
+            }
+        }
+
+        lastEvents_ = packet;
+        _packet = packet;
+        return more;
+    }
+
+
+    bool DatasetStreamer::step(){
         
-        iss >> timestamp >> x >> y >> pol;
-        if (iss.good()){
+        dv::Event event;
+        bool valid;
+        if (!readEvent(event, valid)){
             datasetFile_.close();
             return false;
         }
-        dv::Event event(static_cast<int64_t>(timestamp * 1000000) , static_cast<int16_t>(x) , static_cast<int16_t>(y) , static_cast<uint8_t>(pol));
+
+        // skip malformed lines
+        if (!valid){
+            return true;
+        }
         
         lastEvents_.add(event); 
 
@@ -61,6 +230,282 @@ namespace dvsal{
     }
     
 
+    bool DatasetStreamer::rewind(uint64_t _offset){
+        if (!datasetFile_.is_open())
+            datasetFile_.open(datasetPath_, std::ios::binary);
+        datasetFile_.clear();
+        datasetFile_.seekg(_offset);
+        if (!datasetFile_){
+            std::cout << "Could not seek in dataset file" << std::endl;
+            return false;
+        }
+
+        bufferBegin_ = bufferEnd_ = 0;
+        bufferOffset_ = _offset;
+        endOfFile_ = false;
+        lastEvents_ = dv::EventStore();
+        consumed_ = 0;
+        return true;
+    }
+
+    bool DatasetStreamer::parseChunks(std::vector<EventBatch> &_chunks){
+        _chunks.clear();
+
+        const int fd = open(datasetPath_.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0){
+            std::cout << "Could not open dataset file" << std::endl;
+            if (fd >= 0)
+                close(fd);
+            return false;
+        }
+        const std::size_t bytes = info.st_size;
+        if (bytes == 0){
+            close(fd);
+            return true;
+        }
+
+        void *memory = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED){
+            std::cout << "Could not map dataset file" << std::endl;
+            return false;
+        }
+        madvise(memory, bytes, MADV_SEQUENTIAL);
+        const char *data = static_cast<const char *>(memory);
+
+        // chunks of whole lines, a few per worker to balance them
+        ThreadPool &pool = ThreadPool::global();
+        const std::size_t chunks = std::max<std::size_t>(1, std::min(pool.size()*4, bytes/(1 << 16)));
+        std::vector<std::size_t> bounds(chunks + 1, bytes);
+        bounds[0] = 0;
+        for (std::size_t i = 1; i < chunks; i++){
+            const std::size_t guess = std::max(bounds[i-1], bytes/chunks*i);
+            const void *lineBreak = std::memchr(data + guess, '\n', bytes - guess);
+            bounds[i] = lineBreak == nullptr ? bytes : static_cast<const char *>(lineBreak) - data + 1;
+        }
+
+        _chunks.resize(chunks);
+        ThreadPool::TaskGroup tasks(pool);
+        for (std::size_t i = 0; i < chunks; i++){
+            tasks.run([&, i](){
+                EventBatch &out = _chunks[i];
+                const char *p = data + bounds[i];
+                const char *end = data + bounds[i+1];
+                while (p < end){
+                    const char *lineBreak = static_cast<const char *>(std::memchr(p, '\n', end - p));
+                    const char *lineEnd = lineBreak == nullptr ? end : lineBreak;
+
+                    // skip malformed lines
+                    dv::Event event;
+                    if (parseEvent(p, lineEnd, event)){
+                        out.push_back(event);
+                    }
+                    p = lineEnd + 1;
+                }
+            });
+        }
+        tasks.wait();
+        munmap(memory, bytes);
+        return true;
+    }
+
+    bool DatasetStreamer::loadAll(std::vector<dv::Event> &_events){
+        std::vector<EventBatch> chunks;
+        if (!parseChunks(chunks)){
+            _events.clear();
+            return false;
+        }
+
+        // stitch in file order, every chunk writing its own range
+        std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+        for (std::size_t i = 0; i < chunks.size(); i++){
+            offsets[i+1] = offsets[i] + chunks[i].size();
+        }
+        _events.resize(offsets.back());
+
+        ThreadPool::TaskGroup tasks;
+        for (std::size_t i = 0; i < chunks.size(); i++){
+            tasks.run([&, i](){
+                EventBatch &in = chunks[i];
+                dv::Event *out = _events.data() + offsets[i];
+                for (std::size_t k = 0; k < in.size(); k++){
+                    out[k] = in.event(k);
+                }
+                in = EventBatch();
+            });
+        }
+        tasks.wait();
+        return true;
+    }
+
+    bool DatasetStreamer::loadAll(EventBatch &_events){
+        std::vector<EventBatch> chunks;
+        if (!parseChunks(chunks)){
+            _events.clear();
+            return false;
+        }
+
+        std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+        for (std::size_t i = 0; i < chunks.size(); i++){
+            offsets[i+1] = offsets[i] + chunks[i].size();
+        }
+        _events.clear();
+        _events.resize(offsets.back());
+
+        // columns are copied concurrently; the polarity bitplane afterwards, chunks may share
+        // its words at their boundaries
+        ThreadPool::TaskGroup tasks;
+        for (std::size_t i = 0; i < chunks.size(); i++){
+            tasks.run([&, i](){
+                const EventBatch &in = chunks[i];
+                std::copy(in.timestamps(), in.timestamps() + in.size(), _events.timestamps() + offsets[i]);
+                std::copy(in.xs(), in.xs() + in.size(), _events.xs() + offsets[i]);
+                std::copy(in.ys(), in.ys() + in.size(), _events.ys() + offsets[i]);
+            });
+        }
+        tasks.wait();
+
+        for (std::size_t i = 0; i < chunks.size(); i++){
+            for (std::size_t k = 0; k < chunks[i].size(); k++){
+                if (chunks[i].polarity(k))
+                    _events.setPolarity(offsets[i] + k, true);
+            }
+        }
+        return true;
+    }
+
+    bool DatasetStreamer::loadAll(dv::EventStore &_events){
+        std::vector<dv::Event> events;
+        if (!loadAll(events)){
+            return false;
+        }
+
+        dv::EventStore store;
+        for (const auto &e : events){
+            store.add(e);
+        }
+        _events = store;
+        return true;
+    }
+
+    bool DatasetStreamer::buildIndex(){
+        index_.clear();
+        indexComplete_ = false;
+        indexing_ = true;
+        eventsSinceEntry_ = 0;
+        if (!rewind(0)){
+            indexing_ = false;
+            return false;
+        }
+
+        dv::Event event;
+        bool valid;
+        while (readEvent(event, valid)){
+        }
+        return rewind(0);
+    }
+
+    bool DatasetStreamer::seek(int64_t _timestamp){
+        if (!indexComplete_ && !buildIndex()){
+            return false;
+        }
+
+        // resume from the last entry before _timestamp, then skip to the first event at or after
+        // it. An entry at _timestamp may sit inside a run of equal timestamps, resuming from it
+        // would skip the first events of the run.
+        auto entry = std::lower_bound(index_.begin(), index_.end(), _timestamp,
+                                      [](const IndexEntry &_entry, int64_t _t){ return _entry.timestamp < _t; });
+        const uint64_t offset = entry == index_.begin() ? 0 : (entry - 1)->offset;
+        indexing_ = false;
+        if (!rewind(offset)){
+            return false;
+        }
+
+        const char *begin, *end;
+        while (nextLine(begin, end)){
+            dv::Event event;
+            if (parseEvent(begin, end, event) && event.timestamp() >= _timestamp){
+                // the line is still in the buffer, read it again next
+                bufferBegin_ = begin - buffer_.data();
+                break;
+            }
+        }
+        return true;
+    }
+
+    namespace{
+        const uint32_t IndexMagic = 0x49455644;  // "DVEI"
+
+        // size and modification time of the dataset, to detect stale indices
+        bool fileStamp(const std::string &_path, uint64_t &_size, int64_t &_time){
+            std::error_code error;
+            _size = std::filesystem::file_size(_path, error);
+            if (error)
+                return false;
+            _time = std::filesystem::last_write_time(_path, error).time_since_epoch().count();
+            return !error;
+        }
+    }
+
+    bool DatasetStreamer::loadIndex(){
+        std::ifstream file(datasetPath_ + ".idx", std::ios::binary);
+        if (!file.is_open()){
+            return false;
+        }
+
+        uint32_t magic = 0;
+        uint64_t size = 0, entries = 0;
+        int64_t time = 0;
+        file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char *>(&size), sizeof(size));
+        file.read(reinterpret_cast<char *>(&time), sizeof(time));
+        file.read(reinterpret_cast<char *>(&entries), sizeof(entries));
+
+        uint64_t currentSize;
+        int64_t currentTime;
+        if (!file || magic != IndexMagic || !fileStamp(datasetPath_, currentSize, currentTime) ||
+                size != currentSize || time != currentTime){
+            std::cout << "Ignoring stale seek index " << datasetPath_ << ".idx" << std::endl;
+            return false;
+        }
+
+        // the entries must all be in the file
+        std::error_code error;
+        const uint64_t indexBytes = std::filesystem::file_size(datasetPath_ + ".idx", error);
+        const uint64_t headerBytes = sizeof(magic) + sizeof(size) + sizeof(time) + sizeof(entries);
+        if (error || indexBytes < headerBytes || entries > (indexBytes - headerBytes)/sizeof(IndexEntry)){
+            std::cout << "Ignoring corrupted seek index " << datasetPath_ << ".idx" << std::endl;
+            return false;
+        }
+
+        index_.resize(entries);
+        file.read(reinterpret_cast<char *>(index_.data()), entries*sizeof(IndexEntry));
+        return bool(file);
+    }
+
+    bool DatasetStreamer::saveIndex() const{
+        uint64_t size;
+        int64_t time;
+        if (!fileStamp(datasetPath_, size, time)){
+            return false;
+        }
+
+        std::ofstream file(datasetPath_ + ".idx", std::ios::binary);
+        if (!file.is_open()){
+            std::cout << "Could not write seek index " << datasetPath_ << ".idx" << std::endl;
+            return false;
+        }
+
+        const uint64_t entries = index_.size();
+        file.write(reinterpret_cast<const char *>(&IndexMagic), sizeof(IndexMagic));
+        file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char *>(&time), sizeof(time));
+        file.write(reinterpret_cast<const char *>(&entries), sizeof(entries));
+        file.write(reinterpret_cast<const char *>(index_.data()), entries*sizeof(IndexEntry));
+        return bool(file);
+    }
+
     void DatasetStreamer::events(dv::EventStore &_events , int _microseconds){
         lastEvents_ = lastEvents_.sliceTime(_microseconds);
         _events = lastEvents_;
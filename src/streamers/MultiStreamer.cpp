@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/streamers/MultiStreamer.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace dvsal{
+
+    MultiStreamer::MultiStreamer(const std::vector<Streamer *> &_sources, int64_t _reorderWindow, std::size_t _sourceBatch) :
+            reorderWindow_(_reorderWindow), sourceBatch_(_sourceBatch > 0 ? _sourceBatch : 1){
+        for (auto source : _sources){
+            Source s;
+            s.streamer = source;
+            sources_.push_back(std::move(s));
+        }
+        heap_.reserve(sources_.size());
+    }
+
+    MultiStreamer::~MultiStreamer(){
+        stopStreaming();
+    }
+
+    bool MultiStreamer::init(){
+        bool ok = true;
+        for (auto &source : sources_){
+            ok = source.streamer->init() && ok;
+        }
+        return ok;
+    }
+
+    bool MultiStreamer::step(){
+        dv::EventStore packet;
+        const bool more = nextPacket(packet, sourceBatch_);
+        return more;
+    }
+
+    void MultiStreamer::pushHeap(std::size_t _idx){
+        Source &source = sources_[_idx];
+        heap_.emplace_back(source.events[source.next].timestamp(), _idx);
+        std::push_heap(heap_.begin(), heap_.end(), std::greater<std::pair<int64_t, std::size_t>>());
+        source.queued = true;
+    }
+
+    void MultiStreamer::refill(std::size_t _idx){
+        Source &source = sources_[_idx];
+        dv::EventStore packet;
+        source.alive = source.streamer->nextPacket(packet, sourceBatch_);
+
+        source.events.assign(packet.begin(), packet.end());
+        source.next = 0;
+        if (!source.events.empty()){
+            newest_ = std::max(newest_, source.events.back().timestamp());
+            pushHeap(_idx);
+        }
+    }
+
+    bool MultiStreamer::nextPacket(dv::EventStore &_packet, std::size_t _maxEvents){
+        if (_maxEvents == 0){
+            _packet = dv::EventStore();
+            return false;
+        }
+
+        const auto greater = std::greater<std::pair<int64_t, std::size_t>>();
+
+        // poll the sources without pending events, idle live sources hold the merge back
+        bool idle = false;
+        for (std::size_t i = 0; i < sources_.size(); i++){
+            if (!sources_[i].queued && sources_[i].alive){
+                refill(i);
+                idle = idle || !sources_[i].queued;
+            }
+        }
+
+        dv::EventStore packet;
+        sourceIds_.clear();
+        std::size_t size = 0;
+        while (size < _maxEvents && !heap_.empty()){
+            std::pop_heap(heap_.begin(), heap_.end(), greater);
+            const std::size_t idx = heap_.back().second;
+            heap_.pop_back();
+            Source &source = sources_[idx];
+            source.queued = false;
+
+            // copy the run of events not newer than the next event of the other sources
+            int64_t bound = heap_.empty() ? INT64_MAX : heap_.front().first;
+            if (idle)
+                bound = std::min(bound, newest_ - reorderWindow_);
+
+            const std::size_t first = source.next;
+            while (size < _maxEvents && source.next < source.events.size() && source.events[source.next].timestamp() <= bound){
+                packet.add(source.events[source.next++]);
+                size++;
+            }
+            sourceIds_.insert(sourceIds_.end(), source.next - first, static_cast<uint16_t>(idx));
+
+            if (source.next < source.events.size()){
+                pushHeap(idx);
+                if (source.next == first)
+                    break;  // held back by an idle source
+            }
+            else if (source.alive){
+                refill(idx);
+                if (!source.queued){
+                    // the source went idle, do not merge past it
+                    idle = true;
+                }
+            }
+        }
+
+        lastEvents_ = packet;
+        _packet = packet;
+
+        if (!heap_.empty())
+            return true;
+        for (const auto &source : sources_){
+            if (source.alive)
+                return true;
+        }
+        return false;
+    }
+
+    void MultiStreamer::events(dv::EventStore &_events , int _microseconds){
+        lastEvents_ = lastEvents_.sliceTime(_microseconds);
+        _events = lastEvents_;
+    }
+
+    bool MultiStreamer::image(cv::Mat &_image){
+        for (const auto &event : lastEvents_) {
+            if (event.polarity())
+                _image.at<cv::Vec3b>(event.y(), event.x()) = cv::Vec3b(0,0,255);
+            else
+                _image.at<cv::Vec3b>(event.y(), event.x()) = cv::Vec3b(0,255,0);
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,294 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/streamers/SharedMemoryStreamer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dvsal{
+
+    static_assert(std::is_trivially_copyable<dv::Event>::value, "events are copied to shared memory as bytes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring indices are shared between processes");
+
+    namespace{
+        const uint32_t RingMagic = 0x52455644;  // "DVER"
+
+        // the events start on a cache line after the header
+        std::size_t headerBytes(){
+            return (sizeof(SharedEventRing) + 63) & ~std::size_t(63);
+        }
+
+        // mark the ring of an existing segment closed, for the readers still mapped to it
+        void closeExisting(const std::string &_name){
+            const int fd = shm_open(_name.c_str(), O_RDWR, 0);
+            if (fd < 0){
+                return;
+            }
+            struct stat info;
+            if (fstat(fd, &info) == 0 && std::size_t(info.st_size) >= headerBytes()){
+                void *memory = mmap(nullptr, headerBytes(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (memory != MAP_FAILED){
+                    SharedEventRing *ring = static_cast<SharedEventRing *>(memory);
+                    if (ring->magic == RingMagic)
+                        ring->closed.store(1, std::memory_order_release);
+                    munmap(memory, headerBytes());
+                }
+            }
+            ::close(fd);
+        }
+
+        // whether the publisher is gone: closed the ring, was replaced or died
+        bool publisherGone(const SharedEventRing *_ring){
+            if (_ring->closed.load(std::memory_order_acquire))
+                return true;
+            return kill(pid_t(_ring->publisherPid), 0) != 0 && errno == ESRCH;
+        }
+    }
+
+    SharedMemoryPublisher::SharedMemoryPublisher(const std::string &_name, std::size_t _capacity) : name_(_name){
+        capacity_ = 1;
+        while (capacity_ < _capacity)
+            capacity_ <<= 1;
+    }
+
+    SharedMemoryPublisher::~SharedMemoryPublisher(){
+        close();
+    }
+
+    bool SharedMemoryPublisher::init(){
+        closeExisting(name_);
+        shm_unlink(name_.c_str());
+        const int fd = shm_open(name_.c_str(), O_CREAT | O_RDWR, 0644);
+        if (fd < 0){
+            std::cout << "Could not create shared memory segment " << name_ << std::endl;
+            return false;
+        }
+
+        bytes_ = headerBytes() + capacity_*sizeof(dv::Event);
+        if (ftruncate(fd, bytes_) != 0){
+            std::cout << "Could not size shared memory segment " << name_ << std::endl;
+            ::close(fd);
+            shm_unlink(name_.c_str());
+            return false;
+        }
+
+        void *memory = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED){
+            std::cout << "Could not map shared memory segment " << name_ << std::endl;
+            shm_unlink(name_.c_str());
+            return false;
+        }
+
+        ring_ = new (memory) SharedEventRing();
+        ring_->eventSize = sizeof(dv::Event);
+        ring_->capacity = capacity_;
+        ring_->publisherPid = getpid();
+        ring_->reserveIndex = 0;
+        ring_->writeIndex = 0;
+        ring_->packets = 0;
+        ring_->closed = 0;
+        events_ = reinterpret_cast<dv::Event *>(static_cast<char *>(memory) + headerBytes());
+
+        // readers check the magic last
+        std::atomic_thread_fence(std::memory_order_release);
+        ring_->magic = RingMagic;
+        return true;
+    }
+
+    void SharedMemoryPublisher::publish(const dv::EventStore &_events){
+        if (ring_ == nullptr){
+            return;
+        }
+
+        uint64_t index = ring_->writeIndex.load(std::memory_order_relaxed);
+        auto it = _events.begin();
+        std::size_t remaining = _events.size();
+        while (remaining > 0){
+            // at most one ring per round, so readers can validate every slot
+            const std::size_t size = std::min(remaining, capacity_);
+            ring_->reserveIndex.store(index + size, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (std::size_t i = 0; i < size; i++, ++it){
+                events_[(index + i) & (capacity_ - 1)] = *it;
+            }
+
+            index += size;
+            remaining -= size;
+            ring_->writeIndex.store(index, std::memory_order_release);
+        }
+        ring_->packets.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void SharedMemoryPublisher::close(){
+        if (ring_ == nullptr){
+            return;
+        }
+        ring_->closed.store(1, std::memory_order_release);
+        munmap(ring_, bytes_);
+        shm_unlink(name_.c_str());
+        ring_ = nullptr;
+        events_ = nullptr;
+    }
+
+    SharedMemoryStreamer::SharedMemoryStreamer(const std::string &_name) : name_(_name){
+    }
+
+    SharedMemoryStreamer::~SharedMemoryStreamer(){
+        stopStreaming();
+        if (ring_ != nullptr){
+            munmap(const_cast<SharedEventRing *>(ring_), bytes_);
+        }
+    }
+
+    bool SharedMemoryStreamer::init(){
+        const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+        if (fd < 0){
+            std::cout << "Shared memory segment " << name_ << " not found" << std::endl;
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || std::size_t(info.st_size) < headerBytes()){
+            std::cout << "Shared memory segment " << name_ << " not ready" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        bytes_ = info.st_size;
+
+        void *memory = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED){
+            std::cout << "Could not map shared memory segment " << name_ << std::endl;
+            return false;
+        }
+
+        ring_ = static_cast<const SharedEventRing *>(memory);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (ring_->magic != RingMagic || ring_->eventSize != sizeof(dv::Event) ||
+                headerBytes() + ring_->capacity*sizeof(dv::Event) > bytes_){
+            std::cout << "Shared memory segment " << name_ << " is not an event ring" << std::endl;
+            munmap(memory, bytes_);
+            ring_ = nullptr;
+            return false;
+        }
+        events_ = reinterpret_cast<const dv::Event *>(static_cast<const char *>(memory) + headerBytes());
+
+        readIndex_ = ring_->writeIndex.load(std::memory_order_acquire);
+        return true;
+    }
+
+    bool SharedMemoryStreamer::step(){
+        dv::EventStore packet;
+        return nextPacket(packet, 1 << 16);
+    }
+
+    bool SharedMemoryStreamer::nextPacket(dv::EventStore &_packet, std::size_t _maxEvents){
+        if (_maxEvents == 0){
+            _packet = dv::EventStore();
+            return false;
+        }
+
+        _packet = dv::EventStore();
+        if (ring_ == nullptr){
+            return false;
+        }
+
+        const uint64_t capacity = ring_->capacity;
+        uint64_t written = ring_->writeIndex.load(std::memory_order_acquire);
+        for (int polls = 0; written == readIndex_; polls++){
+            // the publisher liveness costs a system call, check it every ~10 ms only
+            if ((polls % 100 == 0 || ring_->closed.load(std::memory_order_relaxed)) && publisherGone(ring_)){
+                // last check, events may have been written before closing
+                written = ring_->writeIndex.load(std::memory_order_acquire);
+                if (written == readIndex_)
+                    return false;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            written = ring_->writeIndex.load(std::memory_order_acquire);
+        }
+
+        // fell more than a ring behind
+        if (written - readIndex_ > capacity){
+            overruns_ += written - capacity - readIndex_;
+            readIndex_ = written - capacity;
+        }
+
+        const std::size_t size = std::min<uint64_t>(written - readIndex_, _maxEvents);
+
+        // events of the range already overwritten for a reservation
+        auto overwritten = [&](uint64_t _reserved) -> std::size_t {
+            if (_reserved <= capacity || _reserved - capacity <= readIndex_)
+                return 0;
+            return std::min<uint64_t>(size, _reserved - capacity - readIndex_);
+        };
+
+        // skip what is known to be lost, then copy the rest straight into the packet
+        const std::size_t first = overwritten(ring_->reserveIndex.load(std::memory_order_acquire));
+        dv::EventStore packet;
+        for (std::size_t i = first; i < size; i++){
+            packet.add(events_[(readIndex_ + i) & (capacity - 1)]);
+        }
+
+        // drop the copied events the writer may have overwritten meanwhile
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::size_t torn = overwritten(ring_->reserveIndex.load(std::memory_order_relaxed));
+        if (torn > first){
+            packet = torn < size ? packet.slice(torn - first) : dv::EventStore();
+        }
+        overruns_ += std::max(first, torn);
+        readIndex_ += size;
+
+        lastEvents_ = packet;
+        _packet = packet;
+        return true;
+    }
+
+    void SharedMemoryStreamer::events(dv::EventStore &_events , int _microseconds){
+        lastEvents_ = lastEvents_.sliceTime(_microseconds);
+        _events = lastEvents_;
+    }
+
+    bool SharedMemoryStreamer::image(cv::Mat &_image){
+        for (const auto &event : lastEvents_) {
+            if (event.polarity())
+                _image.at<cv::Vec3b>(event.y(), event.x()) = cv::Vec3b(0,0,255);
+            else
+                _image.at<cv::Vec3b>(event.y(), event.x()) = cv::Vec3b(0,255,0);
+        }
+        return true;
+    }
+
+}
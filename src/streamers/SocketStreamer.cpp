@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/streamers/SocketStreamer.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace dvsal{
+
+    static_assert(sizeof(SocketEvent) == 16, "wire format of the events");
+
+    namespace{
+        const uint32_t PacketMagic = 0x50455644;  // "DVEP"
+
+        struct PacketHeader{
+            uint32_t magic;
+            uint32_t size;
+        };
+
+        // fill _address from "unix:<path>" or "<ipv4>:<port>"
+        bool parseAddress(const std::string &_text, sockaddr_storage &_address, socklen_t &_length){
+            std::memset(&_address, 0, sizeof(_address));
+            if (_text.compare(0, 5, "unix:") == 0){
+                sockaddr_un *address = reinterpret_cast<sockaddr_un *>(&_address);
+                const std::string path = _text.substr(5);
+                if (path.empty() || path.size() >= sizeof(address->sun_path))
+                    return false;
+                address->sun_family = AF_UNIX;
+                std::strcpy(address->sun_path, path.c_str());
+                _length = sizeof(sockaddr_un);
+                return true;
+            }
+
+            const std::size_t colon = _text.rfind(':');
+            if (colon == std::string::npos)
+                return false;
+            sockaddr_in *address = reinterpret_cast<sockaddr_in *>(&_address);
+            address->sin_family = AF_INET;
+            address->sin_port = htons(static_cast<uint16_t>(std::atoi(_text.c_str() + colon + 1)));
+            if (inet_pton(AF_INET, _text.substr(0, colon).c_str(), &address->sin_addr) != 1)
+                return false;
+            _length = sizeof(sockaddr_in);
+            return true;
+        }
+    }
+
+    SocketSender::SocketSender(const std::string &_address) : address_(_address){
+    }
+
+    SocketSender::~SocketSender(){
+        close();
+    }
+
+    bool SocketSender::init(){
+        sockaddr_storage address;
+        socklen_t length;
+        if (!parseAddress(address_, address, length)){
+            std::cout << "Invalid socket address " << address_ << std::endl;
+            return false;
+        }
+
+        socket_ = socket(address.ss_family, SOCK_STREAM, 0);
+        if (socket_ < 0 || connect(socket_, reinterpret_cast<sockaddr *>(&address), length) != 0){
+            std::cout << "Could not connect to " << address_ << std::endl;
+            close();
+            return false;
+        }
+
+        if (address.ss_family == AF_INET){
+            // packets are already batched, do not delay them further
+            int noDelay = 1;
+            setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+        return true;
+    }
+
+    bool SocketSender::send(const dv::EventStore &_events){
+        if (socket_ < 0){
+            return false;
+        }
+        if (_events.isEmpty()){
+            return true;
+        }
+
+        buffer_.resize(_events.size());
+        std::size_t i = 0;
+        for (const auto &e : _events){
+            SocketEvent &out = buffer_[i++];
+            out.timestamp = e.timestamp();
+            out.x = e.x();
+            out.y = e.y();
+            out.polarity = e.polarity() ? 1 : 0;
+            std::memset(out.padding, 0, sizeof(out.padding));
+        }
+
+        PacketHeader header{PacketMagic, static_cast<uint32_t>(buffer_.size())};
+        iovec parts[2];
+        parts[0].iov_base = &header;
+        parts[0].iov_len = sizeof(header);
+        parts[1].iov_base = buffer_.data();
+        parts[1].iov_len = buffer_.size()*sizeof(SocketEvent);
+
+        // header and events in one call, resumed after partial writes
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov = parts;
+        message.msg_iovlen = 2;
+        while (message.msg_iovlen > 0){
+            const ssize_t written = sendmsg(socket_, &message, MSG_NOSIGNAL);
+            if (written < 0){
+                if (errno == EINTR)
+                    continue;
+                std::cout << "Connection to " << address_ << " lost" << std::endl;
+                close();
+                return false;
+            }
+
+            std::size_t remaining = written;
+            while (message.msg_iovlen > 0 && remaining >= message.msg_iov->iov_len){
+                remaining -= message.msg_iov->iov_len;
+                message.msg_iov++;
+                message.msg_iovlen--;
+            }
+            if (message.msg_iovlen > 0){
+                message.msg_iov->iov_base = static_cast<char *>(message.msg_iov->iov_base) + remaining;
+                message.msg_iov->iov_len -= remaining;
+            }
+        }
+        return true;
+    }
+
+    void SocketSender::close(){
+        if (socket_ >= 0){
+            ::close(socket_);
+            socket_ = -1;
+        }
+    }
+
+    SocketStreamer::SocketStreamer(const std::string &_address) : address_(_address){
+    }
+
+    SocketStreamer::~SocketStreamer(){
+        stopStreaming();
+        if (socket_ >= 0)
+            ::close(socket_);
+        if (listener_ >= 0)
+            ::close(listener_);
+        if (address_.compare(0, 5, "unix:") == 0)
+            unlink(address_.c_str() + 5);
+    }
+
+    bool SocketStreamer::init(){
+        sockaddr_storage address;
+        socklen_t length;
+        if (!parseAddress(address_, address, length)){
+            std::cout << "Invalid socket address " << address_ << std::endl;
+            return false;
+        }
+
+        listener_ = socket(address.ss_family, SOCK_STREAM, 0);
+        if (listener_ < 0){
+            std::cout << "Could not create socket for " << address_ << std::endl;
+            return false;
+        }
+        if (address.ss_family == AF_UNIX){
+            unlink(address_.c_str() + 5);
+        }
+        else{
+            int reuse = 1;
+            setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        }
+
+        if (bind(listener_, reinterpret_cast<sockaddr *>(&address), length) != 0 || listen(listener_, 1) != 0){
+            std::cout << "Could not listen on " << address_ << std::endl;
+            ::close(listener_);
+            listener_ = -1;
+            return false;
+        }
+
+        buffer_.resize(1 << 20);
+        return true;
+    }
+
+    bool SocketStreamer::fill(bool _wait){
+        if (socket_ < 0){
+            if (listener_ < 0)
+                return false;
+            socket_ = accept(listener_, nullptr, nullptr);
+            if (socket_ < 0){
+                std::cout << "Could not accept a producer on " << address_ << std::endl;
+                return false;
+            }
+            int size = int(buffer_.size());
+            setsockopt(socket_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+        }
+
+        // keep the unread bytes at the front
+        if (bufferBegin_ > 0){
+            std::memmove(buffer_.data(), buffer_.data() + bufferBegin_, bufferEnd_ - bufferBegin_);
+            bufferEnd_ -= bufferBegin_;
+            bufferBegin_ = 0;
+        }
+
+        for (;;){
+            const ssize_t received = recv(socket_, buffer_.data() + bufferEnd_, buffer_.size() - bufferEnd_, _wait ? 0 : MSG_DONTWAIT);
+            if (received > 0){
+                bufferEnd_ += received;
+                return true;
+            }
+            if (received == 0){
+                return false;
+            }
+            if (errno == EINTR)
+                continue;
+            // nothing pending without waiting is not a disconnection
+            return !_wait && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+    }
+
+    bool SocketStreamer::step(){
+        dv::EventStore packet;
+        return nextPacket(packet, 1 << 16);
+    }
+
+    bool SocketStreamer::nextPacket(dv::EventStore &_packet, std::size_t _maxEvents){
+        if (_maxEvents == 0){
+            _packet = dv::EventStore();
+            return false;
+        }
+
+        dv::EventStore packet;
+        std::size_t size = 0;
+        while (size < _maxEvents){
+            const std::size_t available = bufferEnd_ - bufferBegin_;
+
+            if (packetRemaining_ == 0){
+                if (available >= sizeof(PacketHeader)){
+                    PacketHeader header;
+                    std::memcpy(&header, buffer_.data() + bufferBegin_, sizeof(header));
+                    if (header.magic != PacketMagic){
+                        std::cout << "Corrupted event stream on " << address_ << std::endl;
+                        connected_ = false;
+                        break;
+                    }
+                    packetRemaining_ = header.size;
+                    bufferBegin_ += sizeof(header);
+                    continue;
+                }
+            }
+            else if (available >= sizeof(SocketEvent)){
+                const std::size_t count = std::min<std::size_t>({available/sizeof(SocketEvent), packetRemaining_, _maxEvents - size});
+                for (std::size_t i = 0; i < count; i++){
+                    SocketEvent in;
+                    std::memcpy(&in, buffer_.data() + bufferBegin_ + i*sizeof(SocketEvent), sizeof(in));
+                    packet.add(dv::Event(in.timestamp, in.x, in.y, in.polarity));
+                }
+                bufferBegin_ += count*sizeof(SocketEvent);
+                packetRemaining_ -= count;
+                size += count;
+                continue;
+            }
+
+            // incomplete data: wait only while nothing was read
+            if (!connected_ || !fill(size == 0)){
+                connected_ = false;
+                break;
+            }
+            if (bufferEnd_ - bufferBegin_ == available){
+                break;
+            }
+        }
+
+        lastEvents_ = packet;
+        _packet = packet;
+        return connected_ || size > 0;
+    }
+
+    void SocketStreamer::events(dv::EventStore &_events , int _microseconds){
+        lastEvents_ = lastEvents_.sliceTime(_microseconds);
+        _events = lastEvents_;
+    }
+
+    bool SocketStreamer::image(cv::Mat &_image){
+        for (const auto &event : lastEvents_) {
+            if (event.polarity())
+                _image.at<cv::Vec3b>(event.y(), event.x()) = cv::Vec3b(0,0,255);
+            else
+                _image.at<cv::Vec3b>(event.y(), event.x()) = cv::Vec3b(0,255,0);
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/streamers/Streamer.h>
+
+#include <algorithm>
+
+namespace dvsal{
+
+    bool Streamer::nextPacket(dv::EventStore &_packet, std::size_t _maxEvents){
+        if (_maxEvents == 0){
+            _packet = dv::EventStore();
+            return false;
+        }
+
+        bool more = true;
+        dv::EventStore available = lastEvents();
+        if (available.size() < consumed_){
+            // lastEvents() was sliced by events(), start over from what is left
+            consumed_ = 0;
+        }
+
+        while (more && available.size() - consumed_ < _maxEvents){
+            more = step();
+            available = lastEvents();
+        }
+
+        const std::size_t size = std::min(available.size() - consumed_, _maxEvents);
+        _packet = size > 0 ? available.slice(consumed_, size) : dv::EventStore();
+        consumed_ += size;
+
+        return more || available.size() > consumed_;
+    }
+
+    bool Streamer::nextPacket(EventBatch &_batch, std::size_t _maxEvents){
+        dv::EventStore packet;
+        const bool more = nextPacket(packet, _maxEvents);
+        _batch.assign(packet);
+        return more;
+    }
+
+    std::future<dv::EventStore> Streamer::nextPacketAsync(std::size_t _maxEvents){
+        uint64_t ticket;
+        {
+            std::lock_guard<std::mutex> lock(asyncMutex_);
+            ticket = asyncTickets_++;
+            asyncPending_++;
+        }
+
+        return std::async(std::launch::async, [this, _maxEvents, ticket](){
+            // acquisitions run in the order they were requested, a mutex alone does not
+            // guarantee it
+            {
+                std::unique_lock<std::mutex> lock(asyncMutex_);
+                asyncDone_.wait(lock, [this, ticket](){ return asyncServing_ == ticket; });
+            }
+
+            // pass the turn on and leave, also on exceptions. This is the last access to the
+            // streamer, stopStreaming() may destroy it right after.
+            struct Done{
+                Streamer *streamer;
+                ~Done(){
+                    std::lock_guard<std::mutex> lock(streamer->asyncMutex_);
+                    streamer->asyncServing_++;
+                    streamer->asyncPending_--;
+                    streamer->asyncDone_.notify_all();
+                }
+            } done{this};
+
+            std::lock_guard<std::mutex> lock(acquireMutex_);
+            dv::EventStore packet;
+            nextPacket(packet, _maxEvents);
+            return packet;
+        });
+    }
+
+    bool Streamer::startStreaming(PacketCallback _callback, std::size_t _maxEvents, std::function<void()> _onEnd){
+        if (_maxEvents == 0){
+            std::cout << "Cannot stream packets of 0 events" << std::endl;
+            return false;
+        }
+
+        if (streamingThread_.joinable()){
+            if (streaming_)
+                return false;
+            streamingThread_.join();
+        }
+
+        streaming_ = true;
+        streamingThread_ = std::thread([this, _callback, _maxEvents, _onEnd](){
+            bool more = true;
+            while (more && streaming_){
+                dv::EventStore packet;
+                {
+                    std::lock_guard<std::mutex> lock(acquireMutex_);
+                    more = nextPacket(packet, _maxEvents);
+                }
+                if (!packet.isEmpty())
+                    _callback(packet);
+            }
+            if (!more && _onEnd)
+                _onEnd();
+            streaming_ = false;
+        });
+        return true;
+    }
+
+    void Streamer::stopStreaming(){
+        streaming_ = false;
+        if (streamingThread_.joinable() && streamingThread_.get_id() != std::this_thread::get_id()){
+            streamingThread_.join();
+        }
+
+        std::unique_lock<std::mutex> lock(asyncMutex_);
+        asyncDone_.wait(lock, [this](){ return asyncPending_ == 0; });
+    }
+
+}
@@ -0,0 +1,103 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/utils/EventBatch.h>
+
+namespace dvsal{
+
+  EventBatch::EventBatch(const dv::EventStore &_events){
+    assign(_events);
+  }
+
+  void EventBatch::assign(const dv::EventStore &_events){
+    resize(_events.size());
+    std::size_t i = 0;
+    for (const auto &e : _events){
+      timestamps_[i] = e.timestamp();
+      xs_[i] = e.x();
+      ys_[i] = e.y();
+      setPolarity(i, e.polarity());
+      i++;
+    }
+  }
+
+  void EventBatch::assign(const dv::Event *_events, std::size_t _size){
+    resize(_size);
+    for (std::size_t i = 0; i < _size; i++){
+      timestamps_[i] = _events[i].timestamp();
+      xs_[i] = _events[i].x();
+      ys_[i] = _events[i].y();
+      setPolarity(i, _events[i].polarity());
+    }
+  }
+
+  dv::EventStore EventBatch::toEventStore() const{
+    dv::EventStore store;
+    for (std::size_t i = 0; i < size(); i++){
+      store.add(event(i));
+    }
+    return store;
+  }
+
+  void EventBatch::toEvents(std::vector<dv::Event> &_events) const{
+    _events.resize(size());
+    for (std::size_t i = 0; i < size(); i++){
+      _events[i] = event(i);
+    }
+  }
+
+  void EventBatch::reserve(std::size_t _size){
+    timestamps_.reserve(_size);
+    xs_.reserve(_size);
+    ys_.reserve(_size);
+    polarities_.reserve((_size + 63)/64);
+  }
+
+  void EventBatch::resize(std::size_t _size){
+    const std::size_t previous = size();
+    timestamps_.resize(_size);
+    xs_.resize(_size);
+    ys_.resize(_size);
+    polarities_.resize((_size + 63)/64, 0);
+
+    // a shrink leaves the bits of the dropped events in the last word, clear them on growth
+    if (_size > previous && (previous & 63) != 0)
+      polarities_[previous >> 6] &= (uint64_t(1) << (previous & 63)) - 1;
+  }
+
+  void EventBatch::clear(){
+    timestamps_.clear();
+    xs_.clear();
+    ys_.clear();
+    polarities_.clear();
+  }
+
+  void EventBatch::push_back(const dv::Event &e){
+    const std::size_t idx = size();
+    timestamps_.push_back(e.timestamp());
+    xs_.push_back(e.x());
+    ys_.push_back(e.y());
+    if ((idx & 63) == 0)
+      polarities_.push_back(0);
+    setPolarity(idx, e.polarity());
+  }
+
+} // namespace
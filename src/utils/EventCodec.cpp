@@ -0,0 +1,268 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/utils/EventCodec.h>
+
+#include <algorithm>
+
+namespace dvsal{
+
+  namespace{
+    int bitWidth(uint64_t _value){
+      int bits = 0;
+      while (bits < 64 && (_value >> bits) != 0)
+        bits++;
+      return bits;
+    }
+
+    // _size values of _bits bits from bit _pos. Reads one word past the last value, which the
+    // padding word of every block allows.
+    void unpack(const uint64_t *_data, uint64_t _pos, int _bits, std::size_t _size, uint64_t *_values){
+      if (_bits == 0){
+        std::fill(_values, _values + _size, 0);
+        return;
+      }
+      const uint64_t mask = _bits == 64 ? ~uint64_t(0) : (uint64_t(1) << _bits) - 1;
+      for (std::size_t i = 0; i < _size; i++, _pos += _bits){
+        const uint64_t word = _pos >> 6;
+        const int shift = _pos & 63;
+        // branchless read of a value crossing a word boundary, both shifts stay below 64
+        const uint64_t value = (_data[word] >> shift) | ((_data[word + 1] << 1) << (63 - shift));
+        _values[i] = value & mask;
+      }
+    }
+
+    const uint32_t FileMagic = 0x43455644;  // "DVEC"
+
+    // words of a block with _size events of the given widths, including the padding word
+    uint64_t blockWords(uint64_t _size, int _deltaBits, int _xBits, int _yBits){
+      const uint64_t bits = (_size - 1)*_deltaBits + _size*(_xBits + _yBits + 1);
+      return (bits + 63)/64 + 1;
+    }
+
+    template<typename Type_>
+    void writeValue(std::ostream &_stream, const Type_ &_value){
+      _stream.write(reinterpret_cast<const char *>(&_value), sizeof(_value));
+    }
+
+    template<typename Type_>
+    void readValue(std::istream &_stream, Type_ &_value){
+      _stream.read(reinterpret_cast<char *>(&_value), sizeof(_value));
+    }
+  }
+
+  void EventCodec::append(const dv::EventStore &_events){
+    std::vector<dv::Event> events(_events.begin(), _events.end());
+    append(events.data(), events.size());
+  }
+
+  void EventCodec::append(const dv::Event *_events, std::size_t _size){
+    for (std::size_t first = 0; first < _size; first += BlockSize){
+      appendBlock(_events + first, std::min(BlockSize, _size - first));
+    }
+  }
+
+  void EventCodec::putBits(uint64_t _value, int _bits){
+    if (_bits == 0)
+      return;
+    const uint64_t word = bitPos_ >> 6;
+    const int shift = bitPos_ & 63;
+    data_[word] |= _value << shift;
+    if (shift + _bits > 64)
+      data_[word + 1] |= _value >> (64 - shift);
+    bitPos_ += _bits;
+  }
+
+  void EventCodec::appendBlock(const dv::Event *_events, std::size_t _size){
+    Block block{};
+    block.firstTimestamp = _events[0].timestamp();
+    block.size = static_cast<uint32_t>(_size);
+
+    // ranges of every field
+    int64_t minDelta = 0, maxDelta = 0;
+    int16_t xMin = _events[0].x(), xMax = xMin, yMin = _events[0].y(), yMax = yMin;
+    for (std::size_t i = 1; i < _size; i++){
+      const int64_t delta = _events[i].timestamp() - _events[i-1].timestamp();
+      if (i == 1 || delta < minDelta) minDelta = delta;
+      if (i == 1 || delta > maxDelta) maxDelta = delta;
+      xMin = std::min(xMin, _events[i].x());
+      xMax = std::max(xMax, _events[i].x());
+      yMin = std::min(yMin, _events[i].y());
+      yMax = std::max(yMax, _events[i].y());
+    }
+    block.minDelta = minDelta;
+    block.deltaBits = bitWidth(uint64_t(maxDelta) - uint64_t(minDelta));
+    block.xMin = xMin;
+    block.yMin = yMin;
+    block.xBits = bitWidth(uint16_t(xMax - xMin));
+    block.yBits = bitWidth(uint16_t(yMax - yMin));
+
+    // blocks start on a word, plus one word of padding so reads never cross the end
+    bitPos_ = (bitPos_ + 63) & ~uint64_t(63);
+    block.offset = bitPos_ >> 6;
+    data_.resize(block.offset + blockWords(_size, block.deltaBits, block.xBits, block.yBits), 0);
+
+    for (std::size_t i = 1; i < _size; i++)
+      putBits(uint64_t(_events[i].timestamp() - _events[i-1].timestamp()) - uint64_t(minDelta), block.deltaBits);
+    for (std::size_t i = 0; i < _size; i++)
+      putBits(uint16_t(_events[i].x() - xMin), block.xBits);
+    for (std::size_t i = 0; i < _size; i++)
+      putBits(uint16_t(_events[i].y() - yMin), block.yBits);
+    for (std::size_t i = 0; i < _size; i++)
+      putBits(_events[i].polarity() ? 1 : 0, 1);
+
+    blocks_.push_back(block);
+    size_ += _size;
+  }
+
+  std::size_t EventCodec::decodeBlock(std::size_t _idx, dv::Event *_events) const{
+    const Block &block = blocks_[_idx];
+    const uint64_t *data = data_.data() + block.offset;
+    const std::size_t size = block.size;
+
+    // unpack one field at a time, with a fixed width per loop
+    uint64_t timestamps[BlockSize];
+    uint64_t xs[BlockSize];
+    uint64_t ys[BlockSize];
+    uint64_t pos = 0;
+    unpack(data, pos, block.deltaBits, size - 1, timestamps + 1);
+    pos += (size - 1)*block.deltaBits;
+    unpack(data, pos, block.xBits, size, xs);
+    pos += size*block.xBits;
+    unpack(data, pos, block.yBits, size, ys);
+    pos += size*block.yBits;
+
+    int64_t timestamp = block.firstTimestamp;
+    for (std::size_t i = 0; i < size; i++){
+      if (i > 0)
+        timestamp += block.minDelta + int64_t(timestamps[i]);
+      const uint64_t polPos = pos + i;
+      const uint8_t pol = uint8_t((data[polPos >> 6] >> (polPos & 63)) & 1);
+      _events[i] = dv::Event(timestamp, int16_t(block.xMin + int16_t(xs[i])), int16_t(block.yMin + int16_t(ys[i])), pol);
+    }
+    return size;
+  }
+
+  void EventCodec::decode(std::vector<dv::Event> &_events) const{
+    _events.resize(size_);
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < blocks_.size(); i++){
+      offset += decodeBlock(i, _events.data() + offset);
+    }
+  }
+
+  void EventCodec::decode(dv::EventStore &_events) const{
+    std::vector<dv::Event> events;
+    decode(events);
+    dv::EventStore store;
+    for (const auto &e : events){
+      store.add(e);
+    }
+    _events = store;
+  }
+
+  std::size_t EventCodec::findBlock(int64_t _timestamp) const{
+    auto it = std::upper_bound(blocks_.begin(), blocks_.end(), _timestamp,
+                               [](int64_t _t, const Block &_block){ return _t < _block.firstTimestamp; });
+    return it == blocks_.begin() ? 0 : std::size_t(it - blocks_.begin()) - 1;
+  }
+
+  void EventCodec::clear(){
+    blocks_.clear();
+    data_.clear();
+    bitPos_ = 0;
+    size_ = 0;
+  }
+
+  bool EventCodec::write(std::ostream &_stream) const{
+    // fields one by one, so the file holds no struct padding and does not depend on the layout
+    writeValue(_stream, FileMagic);
+    writeValue(_stream, uint64_t(blocks_.size()));
+    writeValue(_stream, uint64_t(data_.size()));
+    for (const auto &block : blocks_){
+      writeValue(_stream, block.firstTimestamp);
+      writeValue(_stream, block.minDelta);
+      writeValue(_stream, block.offset);
+      writeValue(_stream, block.size);
+      writeValue(_stream, block.deltaBits);
+      writeValue(_stream, block.xBits);
+      writeValue(_stream, block.yBits);
+      writeValue(_stream, block.xMin);
+      writeValue(_stream, block.yMin);
+    }
+    _stream.write(reinterpret_cast<const char *>(data_.data()), data_.size()*sizeof(uint64_t));
+    return bool(_stream);
+  }
+
+  bool EventCodec::read(std::istream &_stream){
+    uint32_t magic = 0;
+    uint64_t blocks = 0, words = 0;
+    readValue(_stream, magic);
+    readValue(_stream, blocks);
+    readValue(_stream, words);
+    if (!_stream || magic != FileMagic){
+      std::cout << "Not an encoded event stream" << std::endl;
+      return false;
+    }
+
+    // the counts are not trusted either, containers grow with what is actually read
+    clear();
+    for (uint64_t i = 0; i < blocks && _stream; i++){
+      Block block{};
+      readValue(_stream, block.firstTimestamp);
+      readValue(_stream, block.minDelta);
+      readValue(_stream, block.offset);
+      readValue(_stream, block.size);
+      readValue(_stream, block.deltaBits);
+      readValue(_stream, block.xBits);
+      readValue(_stream, block.yBits);
+      readValue(_stream, block.xMin);
+      readValue(_stream, block.yMin);
+      blocks_.push_back(block);
+    }
+
+    const uint64_t chunk = 1 << 20;
+    for (uint64_t read = 0; read < words && _stream; read += chunk){
+      const uint64_t count = std::min(chunk, words - read);
+      data_.resize(read + count);
+      _stream.read(reinterpret_cast<char *>(data_.data() + read), count*sizeof(uint64_t));
+    }
+    if (!_stream){
+      std::cout << "Truncated encoded event stream" << std::endl;
+      clear();
+      return false;
+    }
+
+    // decodeBlock unpacks to arrays of BlockSize and reads the padding word of every block
+    for (const auto &block : blocks_){
+      if (block.size == 0 || block.size > BlockSize || block.deltaBits > 64 || block.xBits > 16 || block.yBits > 16 ||
+          block.offset > words || blockWords(block.size, block.deltaBits, block.xBits, block.yBits) > words - block.offset){
+        std::cout << "Corrupted encoded event stream" << std::endl;
+        clear();
+        return false;
+      }
+      size_ += block.size;
+    }
+    bitPos_ = data_.size()*64;
+    return true;
+  }
+
+} // namespace
@@ -0,0 +1,200 @@
+//---------------------------------------------------------------------------------------------------------------------
+//  DVSAL
+//---------------------------------------------------------------------------------------------------------------------
+//  Copyright 2020 - Marco Montes Grova (a.k.a. mgrova) marrcogrova@gmail.com 
+//---------------------------------------------------------------------------------------------------------------------
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+//  and associated documentation files (the "Software"), to deal in the Software without restriction, 
+//  including without limitation the rights to use, copy, modify, merge, publish, distribute, 
+//  sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is 
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or substantial 
+//  portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING 
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES 
+//  OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//---------------------------------------------------------------------------------------------------------------------
+
+#include <dvsal/utils/ThreadPool.h>
+
+#include <chrono>
+#include <cstdlib>
+
+namespace dvsal{
+
+  namespace{
+    // pool and worker index of the calling thread, -1 outside of the workers
+    thread_local ThreadPool *currentPool = nullptr;
+    thread_local int currentWorker = -1;
+
+    std::mutex globalMutex;
+    std::unique_ptr<ThreadPool> globalPool;
+    std::size_t globalThreads = 0;
+  }
+
+  ThreadPool::ThreadPool(std::size_t _threads){
+    if (_threads == 0){
+      _threads = 1;
+    }
+    for (std::size_t i = 0; i < _threads; i++){
+      workers_.emplace_back(new Worker());
+    }
+    for (std::size_t i = 0; i < _threads; i++){
+      workers_[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+  }
+
+  ThreadPool::~ThreadPool(){
+    {
+      std::lock_guard<std::mutex> lock(wakeMutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker : workers_){
+      worker->thread.join();
+    }
+  }
+
+  ThreadPool &ThreadPool::global(){
+    std::lock_guard<std::mutex> lock(globalMutex);
+    if (!globalPool){
+      std::size_t threads = globalThreads;
+      if (threads == 0){
+        const char *env = std::getenv("DVSAL_THREADS");
+        threads = env != nullptr ? std::strtoul(env, nullptr, 10) : 0;
+      }
+      if (threads == 0){
+        threads = std::thread::hardware_concurrency();
+      }
+      globalPool.reset(new ThreadPool(threads));
+    }
+    return *globalPool;
+  }
+
+  bool ThreadPool::configureGlobal(std::size_t _threads){
+    std::lock_guard<std::mutex> lock(globalMutex);
+    if (globalPool){
+      return false;
+    }
+    globalThreads = _threads;
+    return true;
+  }
+
+  void ThreadPool::submit(std::function<void()> _task){
+    // workers push to their own deque, other threads spread the tasks
+    const std::size_t idx = currentPool == this ? currentWorker : nextWorker_++ % workers_.size();
+    {
+      std::lock_guard<std::mutex> lock(workers_[idx]->mutex);
+      workers_[idx]->tasks.push_back(std::move(_task));
+    }
+    {
+      std::lock_guard<std::mutex> lock(wakeMutex_);
+      queued_++;
+    }
+    wake_.notify_one();
+  }
+
+  bool ThreadPool::runOne(){
+    if (queued_ == 0){
+      return false;
+    }
+
+    std::function<void()> task;
+    const std::size_t n = workers_.size();
+    const std::size_t self = currentPool == this ? currentWorker : 0;
+
+    // own deque from the back, the others from the front
+    if (currentPool == this){
+      Worker &worker = *workers_[self];
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      if (!worker.tasks.empty()){
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+      }
+    }
+    for (std::size_t k = 1; !task && k <= n; k++){
+      Worker &victim = *workers_[(self + k) % n];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()){
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+      }
+    }
+
+    if (!task){
+      return false;
+    }
+    queued_--;
+    task();
+    return true;
+  }
+
+  void ThreadPool::workerLoop(std::size_t _idx){
+    currentPool = this;
+    currentWorker = static_cast<int>(_idx);
+
+    for (;;){
+      if (runOne()){
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(wakeMutex_);
+      wake_.wait(lock, [this](){ return stop_ || queued_ > 0; });
+      if (stop_ && queued_ == 0){
+        return;
+      }
+    }
+  }
+
+  ThreadPool::TaskGroup::TaskGroup(ThreadPool &_pool) : pool_(_pool){
+  }
+
+  ThreadPool::TaskGroup::~TaskGroup(){
+    try{
+      wait();
+    }
+    catch (...){
+      // errors are only reported through an explicit wait
+    }
+  }
+
+  void ThreadPool::TaskGroup::run(std::function<void()> _task){
+    pending_++;
+    pool_.submit([this, task = std::move(_task)](){
+      try{
+        task();
+      }
+      catch (...){
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_)
+          error_ = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0)
+        done_.notify_all();
+    });
+  }
+
+  void ThreadPool::TaskGroup::wait(){
+    while (pending_ > 0){
+      // help with queued tasks, of this group or not, instead of blocking
+      if (pool_.runOne()){
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_.wait_for(lock, std::chrono::microseconds(200), [this](){ return pending_ == 0; });
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_){
+      std::exception_ptr error = error_;
+      error_ = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+} // namespace